@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    AutomationBenchmark.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../SimpleEQ/Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 128;
+    constexpr int numBlocks = 4000;
+
+    // One continuously automated parameter per band, so every split can dirty every band
+    const char* const sweptParameters[] =
+    {
+        "HighPass Freq",
+        "LowShelf Gain",
+        "Peak 1 Freq",
+        "Peak 2 Gain",
+        "Peak 3 Q",
+        "HighShelf Gain",
+        "LowPass Freq",
+    };
+
+    float getSweepValue(juce::AudioProcessorValueTreeState& apvts, const juce::String& parameterID, int sample)
+    {
+        const auto& range = apvts.getParameter(parameterID)->getNormalisableRange();
+        const auto phase = 0.5f + 0.5f * std::sin((float)sample * 0.0005f);
+
+        return range.convertFrom0to1(phase);
+    }
+
+    void report(const juce::String& name, const BenchmarkResult& result)
+    {
+        std::cout << name.paddedRight(' ', 34)
+                  << juce::String(result.meanMilliseconds * 1000.0, 2).paddedLeft(' ', 10) << " us"
+                  << juce::String(result.worstMilliseconds * 1000.0, 2).paddedLeft(' ', 10) << " us"
+                  << juce::String(getRealtimePercentage(result.worstMilliseconds, blockSize, sampleRate), 2).paddedLeft(' ', 9) << " %"
+                  << std::endl;
+    }
+
+    BenchmarkResult runScenario(int granularity, int eventInterval, bool smoothed)
+    {
+        SimpleEQAudioProcessor processor;
+        processor.setPlayConfigDetails(2, 2, sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+        processor.setAutomationGranularity(granularity);
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::MidiBuffer midi;
+        juce::Random random(1234);
+
+        return measure(numBlocks, [&](int block)
+        {
+            fillWithNoise(buffer, random);
+
+            // Queued in sample order, every band's event at one offset before the next offset
+            if (eventInterval > 0)
+                for (int offset = 0; offset < blockSize; offset += eventInterval)
+                    for (auto* parameterID : sweptParameters)
+                        processor.addParameterEvent(offset, processor.apvts.getParameter(parameterID)->getParameterIndex(),
+                                                    getSweepValue(processor.apvts, parameterID, block * blockSize + offset));
+
+            if (smoothed || eventInterval > 0)
+                for (auto* parameterID : sweptParameters)
+                    setParameter(processor.apvts, parameterID, getSweepValue(processor.apvts, parameterID, (block + 1) * blockSize));
+
+            processor.processBlock(buffer, midi);
+        });
+    }
+}
+
+int runAutomationBenchmark(const juce::StringArray&)
+{
+    std::cout << "Block size " << blockSize << " at " << sampleRate << " Hz, "
+              << (int)std::size(sweptParameters) << " bands automated" << std::endl;
+    std::cout << juce::String("scenario").paddedRight(' ', 34) << "      mean" << "     worst" << "  worst/rt" << std::endl;
+
+    report("static", runScenario(16, 0, false));
+    report("smoothed, granularity 16", runScenario(16, 0, true));
+
+    // Worst case: an event for every band at every allowed split point
+    for (auto granularity : { 64, 16, 4, 1 })
+        report("events every sample, granularity " + juce::String(granularity), runScenario(granularity, 1, false));
+
+    return 0;
+}
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    Benchmarks.h
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+struct BenchmarkResult
+{
+    double meanMilliseconds{ 0 };
+    double worstMilliseconds{ 0 };
+};
+
+// Runs the callback numIterations times and records the mean and worst run
+template <typename Callback>
+BenchmarkResult measure(int numIterations, Callback&& callback)
+{
+    BenchmarkResult result;
+    double total = 0;
+
+    for (int i = 0; i < numIterations; ++i)
+    {
+        const auto start = juce::Time::getMillisecondCounterHiRes();
+        callback(i);
+        const auto elapsed = juce::Time::getMillisecondCounterHiRes() - start;
+
+        total += elapsed;
+        result.worstMilliseconds = juce::jmax(result.worstMilliseconds, elapsed);
+    }
+
+    result.meanMilliseconds = total / juce::jmax(1, numIterations);
+    return result;
+}
+
+// Fills every channel with reproducible white noise at -12 dBFS
+inline void fillWithNoise(juce::AudioBuffer<float>& buffer, juce::Random& random)
+{
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    {
+        auto* data = buffer.getWritePointer(channel);
+
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            data[i] = (random.nextFloat() * 2.f - 1.f) * 0.25f;
+    }
+}
+
+// Sets a parameter by ID, in plain units, the way a host would
+inline void setParameter(juce::AudioProcessorValueTreeState& apvts, const juce::String& parameterID, float value)
+{
+    auto* parameter = apvts.getParameter(parameterID);
+    parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+}
+
+inline double getRealtimePercentage(double milliseconds, int blockSize, double sampleRate)
+{
+    return 100.0 * milliseconds / (1000.0 * blockSize / sampleRate);
+}
+
+int runAutomationBenchmark(const juce::StringArray& args);
+int runBlockBiquadBenchmark(const juce::StringArray& args);
+int runDynamicsBenchmark(const juce::StringArray& args);
+int runLoudnessBenchmark(const juce::StringArray& args);
+int runStateBenchmark(const juce::StringArray& args);
+int runGraphBenchmark(const juce::StringArray& args);
+int runResponseBenchmark(const juce::StringArray& args);
+int runMatchBenchmark(const juce::StringArray& args);
+int runOversamplingBenchmark(const juce::StringArray& args);
+int runCrossoverBenchmark(const juce::StringArray& args);
+int runCoefficientBenchmark(const juce::StringArray& args);
+int runEditorBenchmark(const juce::StringArray& args);
@@ -0,0 +1,221 @@
+/*
+  ==============================================================================
+
+    BlockBiquadBenchmark.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../SimpleEQ/Source/PluginProcessor.h"
+
+namespace
+{
+    using ReferenceFilter = juce::dsp::IIR::Filter<float>;
+    using ReferenceCutFilter = juce::dsp::ProcessorChain<ReferenceFilter, ReferenceFilter, ReferenceFilter, ReferenceFilter>;
+    using ReferenceChain = juce::dsp::ProcessorChain<ReferenceCutFilter, ReferenceFilter, ReferenceFilter, ReferenceFilter, ReferenceFilter, ReferenceFilter, ReferenceCutFilter>;
+
+    using ArrayDesign = juce::dsp::IIR::ArrayCoefficients<float>;
+
+    struct Design
+    {
+        juce::String name;
+        CoefficientArray coefficients;
+    };
+
+    std::vector<Design> getDesigns(double sampleRate)
+    {
+        std::vector<Design> designs;
+
+        for (auto frequency : { 20.f, 200.f, 2000.f, 15000.f })
+        {
+            for (auto q : { 0.1f, 1.f, 10.f })
+            {
+                for (auto gain : { -24.f, 24.f })
+                    designs.push_back({ "peak " + juce::String(frequency) + " Hz Q " + juce::String(q) + " " + juce::String(gain) + " dB",
+                        ArrayDesign::makePeakFilter(sampleRate, frequency, q, juce::Decibels::decibelsToGain(gain)) });
+
+                designs.push_back({ "low shelf " + juce::String(frequency) + " Hz Q " + juce::String(q),
+                    ArrayDesign::makeLowShelf(sampleRate, frequency, q, juce::Decibels::decibelsToGain(12.f)) });
+                designs.push_back({ "high shelf " + juce::String(frequency) + " Hz Q " + juce::String(q),
+                    ArrayDesign::makeHighShelf(sampleRate, frequency, q, juce::Decibels::decibelsToGain(-12.f)) });
+            }
+
+            for (int section = 0; section < 4; ++section)
+            {
+                const auto q = getButterworthQ(8, section);
+                designs.push_back({ "high pass " + juce::String(frequency) + " Hz section " + juce::String(section),
+                    ArrayDesign::makeHighPass(sampleRate, frequency, q) });
+                designs.push_back({ "low pass " + juce::String(frequency) + " Hz section " + juce::String(section),
+                    ArrayDesign::makeLowPass(sampleRate, frequency, q) });
+            }
+        }
+
+        return designs;
+    }
+
+    // Runs the signal through a filter in irregular block sizes, so the scalar
+    // remainder path of BlockBiquad gets exercised as well
+    template <typename FilterType, typename SampleType>
+    void processInChunks(FilterType& filter, std::vector<SampleType>& signal)
+    {
+        const size_t chunkSizes[] = { 512, 7, 128, 33, 1, 64 };
+        size_t position = 0;
+
+        for (size_t chunk = 0; position < signal.size(); ++chunk)
+        {
+            const auto numSamples = juce::jmin(chunkSizes[chunk % std::size(chunkSizes)], signal.size() - position);
+
+            SampleType* channels[] = { signal.data() + position };
+            juce::dsp::AudioBlock<SampleType> block(channels, 1, numSamples);
+            filter.process(juce::dsp::ProcessContextReplacing<SampleType>(block));
+
+            position += numSamples;
+        }
+    }
+
+    template <typename FilterType>
+    void prepareFilter(FilterType& filter, double sampleRate)
+    {
+        filter.prepare({ sampleRate, 512, 1 });
+    }
+
+    // Largest deviation from the double precision reference, relative to its peak
+    double getRelativeError(const std::vector<float>& signal, const std::vector<double>& reference)
+    {
+        double error = 0, peak = 0;
+
+        for (size_t i = 0; i < signal.size(); ++i)
+        {
+            error = juce::jmax(error, std::abs((double)signal[i] - reference[i]));
+            peak = juce::jmax(peak, std::abs(reference[i]));
+        }
+
+        return peak > 0 ? error / peak : error;
+    }
+
+    bool checkEquivalence(double sampleRate)
+    {
+        juce::Random random(42);
+        std::vector<float> input((size_t)sampleRate);
+
+        for (auto& sample : input)
+            sample = (random.nextFloat() * 2.f - 1.f) * 0.25f;
+
+        auto allPassed = true;
+
+        for (const auto& design : getDesigns(sampleRate))
+        {
+            // All three use the same float coefficients, so only the structure differs
+            const auto& c = design.coefficients;
+
+            juce::dsp::IIR::Filter<double> reference(new juce::dsp::IIR::Coefficients<double>(c[0], c[1], c[2], c[3], c[4], c[5]));
+            ReferenceFilter juceFilter(new juce::dsp::IIR::Coefficients<float>(c));
+            BlockBiquad blockFilter;
+            *blockFilter.coefficients = c;
+
+            prepareFilter(reference, sampleRate);
+            prepareFilter(juceFilter, sampleRate);
+            prepareFilter(blockFilter, sampleRate);
+
+            std::vector<double> referenceOutput(input.begin(), input.end());
+            auto juceOutput = input;
+            auto blockOutput = input;
+
+            processInChunks(reference, referenceOutput);
+            processInChunks(juceFilter, juceOutput);
+            processInChunks(blockFilter, blockOutput);
+
+            const auto juceError = getRelativeError(juceOutput, referenceOutput);
+            const auto blockError = getRelativeError(blockOutput, referenceOutput);
+
+            // Equivalent when no worse than a small multiple of IIR::Filter's own rounding
+            const auto passed = blockError <= 10.0 * juceError + 1.0e-6;
+            allPassed = allPassed && passed;
+
+            if (! passed)
+                std::cout << "  FAIL " << design.name << " at " << sampleRate << " Hz: block "
+                          << blockError << ", IIR::Filter " << juceError << std::endl;
+        }
+
+        return allPassed;
+    }
+
+    ChainSettings getBusySettings()
+    {
+        ChainSettings settings;
+        settings.highPassFreq = 40.f;
+        settings.highPassSlope = Slope_48;
+        settings.lowPassFreq = 16000.f;
+        settings.lowPassSlope = Slope_48;
+        settings.lowShelfFreq = 120.f;
+        settings.lowShelfGainInDecibels = 3.f;
+        settings.highShelfFreq = 8000.f;
+        settings.highShelfGainInDecibels = -2.f;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            settings.peakFreq[i] = 300.f * (float)(i + 1) * (float)(i + 1);
+            settings.peakGainInDecibels[i] = 4.f;
+            settings.peakQ[i] = 2.f;
+        }
+
+        return settings;
+    }
+
+    template <typename ChainType>
+    BenchmarkResult timeChain(double sampleRate, int blockSize)
+    {
+        ChainType chain;
+        chain.prepare({ sampleRate, (juce::uint32)blockSize, 1 });
+
+        const auto settings = getBusySettings();
+        updateCutFilter(chain.template get<ChainPositions::HighPass>(), makeHighPassCoefficients(settings, sampleRate), settings.highPassSlope);
+        updateCoefficients(chain.template get<ChainPositions::LowShelf>().coefficients, makeLowShelfCoefficients(settings, sampleRate));
+        updateCoefficients(chain.template get<ChainPositions::Peak1>().coefficients, makePeakCoefficients(settings, sampleRate, 0));
+        updateCoefficients(chain.template get<ChainPositions::Peak2>().coefficients, makePeakCoefficients(settings, sampleRate, 1));
+        updateCoefficients(chain.template get<ChainPositions::Peak3>().coefficients, makePeakCoefficients(settings, sampleRate, 2));
+        updateCoefficients(chain.template get<ChainPositions::HighShelf>().coefficients, makeHighShelfCoefficients(settings, sampleRate));
+        updateCutFilter(chain.template get<ChainPositions::LowPass>(), makeLowPassCoefficients(settings, sampleRate), settings.lowPassSlope);
+
+        juce::AudioBuffer<float> buffer(1, blockSize);
+        juce::Random random(7);
+
+        return measure(20000, [&](int)
+        {
+            fillWithNoise(buffer, random);
+
+            juce::dsp::AudioBlock<float> block(buffer);
+            chain.process(juce::dsp::ProcessContextReplacing<float>(block));
+        });
+    }
+}
+
+int runBlockBiquadBenchmark(const juce::StringArray&)
+{
+    std::cout << "BlockBiquad, " << (int)BlockBiquad::blockLength << " samples per iteration" << std::endl;
+
+    auto allPassed = true;
+
+    for (auto sampleRate : { 44100.0, 48000.0, 96000.0 })
+        allPassed = checkEquivalence(sampleRate) && allPassed;
+
+    std::cout << "Equivalence with juce::dsp::IIR::Filter<float>: " << (allPassed ? "passed" : "FAILED") << std::endl;
+
+    std::cout << "Mono chain, 13 active sections, per block:" << std::endl;
+
+    for (auto blockSize : { 32, 128, 512 })
+    {
+        const auto reference = timeChain<ReferenceChain>(48000.0, blockSize);
+        const auto block = timeChain<MonoChain>(48000.0, blockSize);
+
+        std::cout << "  " << juce::String(blockSize).paddedLeft(' ', 4) << " samples: IIR::Filter "
+                  << juce::String(reference.meanMilliseconds * 1000.0, 2) << " us, BlockBiquad "
+                  << juce::String(block.meanMilliseconds * 1000.0, 2) << " us ("
+                  << juce::String(reference.meanMilliseconds / block.meanMilliseconds, 2) << "x)" << std::endl;
+    }
+
+    return allPassed ? 0 : 1;
+}
@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+
+    CoefficientBenchmark.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../SimpleEQ/Source/FrequencyResponse.h"
+
+namespace
+{
+    constexpr int numPresets = 20000;
+    constexpr int numAccuracyPresets = 2000;
+    constexpr int numGridPoints = 512;
+
+    float randomFrequency(juce::Random& random)
+    {
+        return (float)juce::mapToLog10((double)random.nextFloat(), 20.0, 20000.0);
+    }
+
+    // Off the parameter grid on purpose, modulation and gain reduction land anywhere
+    ChainSettings makeRandomPreset(juce::Random& random)
+    {
+        ChainSettings settings;
+
+        settings.highPassFreq = randomFrequency(random);
+        settings.lowPassFreq = randomFrequency(random);
+        settings.highPassSlope = static_cast<Slope>(random.nextInt(4));
+        settings.lowPassSlope = static_cast<Slope>(random.nextInt(4));
+        settings.lowShelfFreq = randomFrequency(random);
+        settings.lowShelfGainInDecibels = random.nextFloat() * 48.f - 24.f;
+        settings.lowShelfQ = 0.1f + random.nextFloat() * 4.9f;
+        settings.highShelfFreq = randomFrequency(random);
+        settings.highShelfGainInDecibels = random.nextFloat() * 48.f - 24.f;
+        settings.highShelfQ = 0.1f + random.nextFloat() * 4.9f;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            settings.peakFreq[i] = randomFrequency(random);
+            settings.peakGainInDecibels[i] = random.nextFloat() * 48.f - 24.f;
+            settings.peakQ[i] = 0.1f + random.nextFloat() * 9.9f;
+        }
+
+        return settings;
+    }
+
+    void runRate(double sampleRate)
+    {
+        juce::Random random(1234);
+        std::vector<ChainSettings> presets;
+
+        for (int i = 0; i < numPresets; ++i)
+            presets.push_back(makeRandomPreset(random));
+
+        const auto tables = CoefficientTables::get(sampleRate);
+
+        // Summed into a sink so the designs can't be optimised away
+        float sink = 0.f;
+
+        const auto trigonometry = measure(1, [&](int)
+        {
+            for (const auto& preset : presets)
+                sink += makeChainCoefficients(preset, sampleRate).peaks[0][1];
+        });
+
+        const auto tabulated = measure(1, [&](int)
+        {
+            for (const auto& preset : presets)
+                sink += makeChainCoefficients(preset, *tables).peaks[0][1];
+        });
+
+        juce::ignoreUnused(sink);
+
+        // Worst magnitude difference between the two designs, up to 20 kHz or Nyquist
+        const auto grid = FrequencyGrid::logarithmic(numGridPoints, 20.0, juce::jmin(20000.0, 0.49 * sampleRate), sampleRate);
+        FrequencyResponse exact, approximate;
+        auto worstDifference = 0.f;
+
+        for (int i = 0; i < numAccuracyPresets; ++i)
+        {
+            computeFrequencyResponse(makeChainCoefficients(presets[(size_t)i], sampleRate), grid, exact);
+            computeFrequencyResponse(makeChainCoefficients(presets[(size_t)i], *tables), grid, approximate);
+
+            for (size_t point = 0; point < grid.size(); ++point)
+                worstDifference = juce::jmax(worstDifference, std::abs(exact.magnitudeInDecibels[point] - approximate.magnitudeInDecibels[point]));
+        }
+
+        // Seven bands per chain design
+        const auto toNanosecondsPerBand = [](double milliseconds) { return 1.0e6 * milliseconds / (numPresets * 7.0); };
+
+        std::cout << juce::String(sampleRate, 0).paddedLeft(' ', 8) << " Hz"
+                  << juce::String(toNanosecondsPerBand(trigonometry.meanMilliseconds), 1).paddedLeft(' ', 12) << " ns"
+                  << juce::String(toNanosecondsPerBand(tabulated.meanMilliseconds), 1).paddedLeft(' ', 10) << " ns"
+                  << juce::String(trigonometry.meanMilliseconds / tabulated.meanMilliseconds, 2).paddedLeft(' ', 9) << " x"
+                  << juce::String(worstDifference, 4).paddedLeft(' ', 12) << " dB"
+                  << std::endl;
+    }
+}
+
+int runCoefficientBenchmark(const juce::StringArray&)
+{
+    std::cout << numPresets << " random presets, design cost per band, worst magnitude difference over "
+              << numAccuracyPresets << " of them" << std::endl;
+    std::cout << juce::String("rate").paddedLeft(' ', 11) << juce::String("trigonometry").paddedLeft(' ', 15)
+              << juce::String("tables").paddedLeft(' ', 13) << juce::String("speedup").paddedLeft(' ', 11)
+              << juce::String("difference").paddedLeft(' ', 15) << std::endl;
+
+    for (const auto sampleRate : { 44100.0, 48000.0, 96000.0, 192000.0 })
+        runRate(sampleRate);
+
+    return 0;
+}
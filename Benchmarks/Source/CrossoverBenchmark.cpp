@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+    CrossoverBenchmark.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../SimpleEQ/Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 128;
+    constexpr int numBlocks = 4000;
+
+    void setUpEq(SimpleEQAudioProcessor& processor)
+    {
+        setParameter(processor.apvts, "HighPass Freq", 30.f);
+        setParameter(processor.apvts, "Peak 1 Gain", -4.f);
+        setParameter(processor.apvts, "Peak 2 Gain", 3.f);
+        setParameter(processor.apvts, "Peak 3 Gain", 2.f);
+        setParameter(processor.apvts, "LowPass Freq", 18000.f);
+    }
+
+    // The EQ followed by a split, every band output enabled
+    BenchmarkResult runSplit(int numBands, int slope)
+    {
+        SimpleEQAudioProcessor processor;
+        processor.enableAllBuses();
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+
+        setUpEq(processor);
+        setParameter(processor.apvts, "Crossover Bands", (float)(numBands - 1));
+        setParameter(processor.apvts, "Crossover Slope", (float)slope);
+        setParameter(processor.apvts, "Band 1 Gain", 2.f);
+        setParameter(processor.apvts, "Band 3 Gain", -3.f);
+
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        juce::AudioBuffer<float> buffer(processor.getTotalNumOutputChannels(), blockSize);
+        juce::AudioBuffer<float> input(2, blockSize);
+        juce::MidiBuffer midi;
+        juce::Random random(1234);
+
+        return measure(numBlocks, [&](int)
+        {
+            fillWithNoise(input, random);
+            buffer.clear();
+            buffer.copyFrom(0, 0, input, 0, 0, blockSize);
+            buffer.copyFrom(1, 0, input, 1, 0, blockSize);
+            processor.processBlock(buffer, midi);
+        });
+    }
+
+    // What a split costs without the crossover: one EQ instance per band
+    BenchmarkResult runInstances(int numInstances)
+    {
+        std::vector<std::unique_ptr<SimpleEQAudioProcessor>> processors;
+        std::vector<juce::AudioBuffer<float>> buffers;
+
+        for (int i = 0; i < numInstances; ++i)
+        {
+            processors.push_back(std::make_unique<SimpleEQAudioProcessor>());
+            processors.back()->setPlayConfigDetails(2, 2, sampleRate, blockSize);
+            setUpEq(*processors.back());
+            processors.back()->prepareToPlay(sampleRate, blockSize);
+            buffers.emplace_back(2, blockSize);
+        }
+
+        juce::AudioBuffer<float> input(2, blockSize);
+        juce::MidiBuffer midi;
+        juce::Random random(1234);
+
+        return measure(numBlocks, [&](int)
+        {
+            fillWithNoise(input, random);
+
+            for (int i = 0; i < numInstances; ++i)
+            {
+                buffers[(size_t)i].makeCopyOf(input, true);
+                processors[(size_t)i]->processBlock(buffers[(size_t)i], midi);
+            }
+        });
+    }
+}
+
+int runCrossoverBenchmark(const juce::StringArray&)
+{
+    std::cout << "Block size " << blockSize << " at " << sampleRate << " Hz, band outputs enabled" << std::endl;
+    std::cout << juce::String("scenario").paddedRight(' ', 24) << "      mean" << "     worst"
+              << "   vs EQ only" << "  vs instances" << std::endl;
+
+    const auto eqOnly = runSplit(1, 0);
+
+    const auto printRow = [&](const juce::String& name, const BenchmarkResult& result, int numInstances)
+    {
+        const auto instances = runInstances(numInstances);
+
+        std::cout << name.paddedRight(' ', 24)
+                  << juce::String(result.meanMilliseconds * 1000.0, 2).paddedLeft(' ', 10) << " us"
+                  << juce::String(result.worstMilliseconds * 1000.0, 2).paddedLeft(' ', 10) << " us"
+                  << juce::String(result.meanMilliseconds / eqOnly.meanMilliseconds, 2).paddedLeft(' ', 10) << " x"
+                  << juce::String(result.meanMilliseconds / instances.meanMilliseconds, 2).paddedLeft(' ', 13) << " x"
+                  << std::endl;
+    };
+
+    printRow("EQ only", eqOnly, 1);
+
+    for (const auto slope : { 0, 1 })
+        for (const auto numBands : { 2, 3, 4 })
+            printRow(juce::String(numBands) + " bands, " + (slope == 0 ? "24" : "48") + " db/Oct",
+                     runSplit(numBands, slope), numBands);
+
+    return 0;
+}
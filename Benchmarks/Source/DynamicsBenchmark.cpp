@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    DynamicsBenchmark.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../SimpleEQ/Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 128;
+    constexpr int numBlocks = 4000;
+
+    const char* const dynamicBands[] = { "LowShelf", "Peak 1", "Peak 2", "Peak 3", "HighShelf" };
+
+    // Noise bursts that swing well across the thresholds, so gains keep moving
+    void fillWithBursts(juce::AudioBuffer<float>& buffer, juce::Random& random, int block)
+    {
+        fillWithNoise(buffer, random);
+        buffer.applyGain((block / 8) % 2 == 0 ? 4.f : 0.05f);
+    }
+
+    BenchmarkResult runScenario(int numDynamicBands)
+    {
+        SimpleEQAudioProcessor processor;
+        processor.setPlayConfigDetails(2, 2, sampleRate, blockSize);
+
+        for (int i = 0; i < (int)std::size(dynamicBands); ++i)
+        {
+            const juce::String name{ dynamicBands[i] };
+
+            setParameter(processor.apvts, name + " Gain", 6.f);
+            setParameter(processor.apvts, name + " Dynamic", i < numDynamicBands ? 1.f : 0.f);
+            setParameter(processor.apvts, name + " Threshold", -30.f);
+            setParameter(processor.apvts, name + " Ratio", 4.f);
+            setParameter(processor.apvts, name + " Attack", 5.f);
+            setParameter(processor.apvts, name + " Release", 50.f);
+        }
+
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::MidiBuffer midi;
+        juce::Random random(1234);
+
+        return measure(numBlocks, [&](int block)
+        {
+            fillWithBursts(buffer, random, block);
+            processor.processBlock(buffer, midi);
+        });
+    }
+}
+
+int runDynamicsBenchmark(const juce::StringArray&)
+{
+    std::cout << "Block size " << blockSize << " at " << sampleRate << " Hz, noise bursts" << std::endl;
+    std::cout << juce::String("dynamic bands").paddedRight(' ', 16) << "      mean" << "     worst" << "  vs static" << std::endl;
+
+    const auto staticResult = runScenario(0);
+
+    for (auto numDynamicBands : { 0, 1, 3, 5 })
+    {
+        const auto result = numDynamicBands == 0 ? staticResult : runScenario(numDynamicBands);
+
+        std::cout << juce::String(numDynamicBands).paddedRight(' ', 16)
+                  << juce::String(result.meanMilliseconds * 1000.0, 2).paddedLeft(' ', 10) << " us"
+                  << juce::String(result.worstMilliseconds * 1000.0, 2).paddedLeft(' ', 10) << " us"
+                  << juce::String(result.meanMilliseconds / staticResult.meanMilliseconds, 2).paddedLeft(' ', 9) << " x"
+                  << std::endl;
+    }
+
+    return 0;
+}
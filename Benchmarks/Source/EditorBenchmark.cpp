@@ -0,0 +1,285 @@
+/*
+  ==============================================================================
+
+    EditorBenchmark.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../SimpleEQ/Source/PluginProcessor.h"
+#include "../../SimpleEQ/Source/PluginEditor.h"
+#include <ctime>
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 128;
+    constexpr int numConstructions = 50;
+    constexpr int numPaintFrames = 60;
+    constexpr int numStormFrames = 120;
+    constexpr double frameIntervalMilliseconds = 1000.0 / 60.0;
+
+    // What the editor's sliders are attached to
+    const char* const sliderParameters[] =
+    {
+        "HighPass Freq", "HighPass Slope",
+        "LowShelf Freq", "LowShelf Gain", "LowShelf Q",
+        "Peak 1 Freq", "Peak 1 Gain", "Peak 1 Q",
+        "Peak 2 Freq", "Peak 2 Gain", "Peak 2 Q",
+        "Peak 3 Freq", "Peak 3 Gain", "Peak 3 Q",
+        "HighShelf Freq", "HighShelf Gain", "HighShelf Q",
+        "LowPass Freq", "LowPass Slope",
+    };
+
+    struct RenderSize
+    {
+        int width, height;
+    };
+
+    const RenderSize renderSizes[] = { { 1000, 600 }, { 1500, 900 }, { 2000, 1200 } };
+    const float scaleFactors[] = { 1.f, 1.5f, 2.f };
+
+    // CPU time used by the calling thread. Elsewhere than Linux it's the whole
+    // process, which still works as long as nothing else is busy.
+    double getThreadCpuMilliseconds()
+    {
+       #if JUCE_LINUX
+        timespec time;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+        return (double)time.tv_sec * 1000.0 + (double)time.tv_nsec / 1.0e6;
+       #else
+        return 1000.0 * (double)std::clock() / CLOCKS_PER_SEC;
+       #endif
+    }
+
+    void prepare(SimpleEQAudioProcessor& processor)
+    {
+        processor.setPlayConfigDetails(2, 2, sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+    }
+
+    ResponseCurveComponent* findResponseCurve(juce::Component& editor)
+    {
+        for (auto* child : editor.getChildren())
+            if (auto* curve = dynamic_cast<ResponseCurveComponent*>(child))
+                return curve;
+
+        return nullptr;
+    }
+
+    // Software rendered, so it runs the same with no display attached
+    juce::Image makeImage(const juce::Component& component, float scale)
+    {
+        return juce::Image(juce::Image::ARGB,
+                           juce::roundToInt((float)component.getWidth() * scale),
+                           juce::roundToInt((float)component.getHeight() * scale),
+                           true, juce::SoftwareImageType());
+    }
+
+    // Paints the component the way a display with this scale factor would
+    void render(juce::Component& component, juce::Image& image, float scale)
+    {
+        juce::Graphics g(image);
+        g.addTransform(juce::AffineTransform::scale(scale));
+        component.paintEntireComponent(g, false);
+    }
+
+    // Plays the processor in real time on its own thread. Parameters change
+    // from there too, before each block, the way host automation arrives.
+    class AudioDriver : private juce::Thread
+    {
+    public:
+        AudioDriver(SimpleEQAudioProcessor& processorToUse, int changesPerBlockToUse)
+            : juce::Thread("Audio"), processor(processorToUse), changesPerBlock(changesPerBlockToUse)
+        {
+            for (auto* parameterID : sliderParameters)
+                parameters.push_back(processor.apvts.getParameter(parameterID));
+
+            startThread(juce::Thread::Priority::highest);
+        }
+
+        ~AudioDriver() override
+        {
+            stopThread(2000);
+        }
+
+    private:
+        void run() override
+        {
+            juce::AudioBuffer<float> buffer(2, blockSize);
+            juce::MidiBuffer midi;
+            juce::Random random(1234);
+
+            const auto blockInterval = 1000.0 * blockSize / sampleRate;
+            auto nextBlock = juce::Time::getMillisecondCounterHiRes();
+
+            while (! threadShouldExit())
+            {
+                for (int i = 0; i < changesPerBlock; ++i)
+                    parameters[(size_t)random.nextInt((int)parameters.size())]->setValueNotifyingHost(random.nextFloat());
+
+                fillWithNoise(buffer, random);
+                processor.processBlock(buffer, midi);
+
+                nextBlock += blockInterval;
+
+                if (const auto wait = nextBlock - juce::Time::getMillisecondCounterHiRes(); wait >= 1.0)
+                    juce::Thread::sleep((int)wait);
+            }
+        }
+
+        SimpleEQAudioProcessor& processor;
+        const int changesPerBlock;
+        std::vector<juce::AudioProcessorParameter*> parameters;
+    };
+
+    void runConstruction()
+    {
+        SimpleEQAudioProcessor processor;
+        prepare(processor);
+
+        std::vector<std::unique_ptr<SimpleEQAudioProcessorEditor>> editors((size_t)numConstructions);
+
+        const auto construction = measure(numConstructions, [&](int i)
+        {
+            editors[(size_t)i] = std::make_unique<SimpleEQAudioProcessorEditor>(processor);
+        });
+
+        const auto destruction = measure(numConstructions, [&](int i)
+        {
+            editors[(size_t)i].reset();
+        });
+
+        std::cout << "Editor with " << std::size(sliderParameters) << " slider attachments, "
+                  << processor.getParameters().size() << " parameter listeners" << std::endl;
+        std::cout << juce::String("construct").paddedRight(' ', 12)
+                  << juce::String(construction.meanMilliseconds, 3).paddedLeft(' ', 10) << " ms mean"
+                  << juce::String(construction.worstMilliseconds, 3).paddedLeft(' ', 10) << " ms worst" << std::endl;
+        std::cout << juce::String("destroy").paddedRight(' ', 12)
+                  << juce::String(destruction.meanMilliseconds, 3).paddedLeft(' ', 10) << " ms mean"
+                  << juce::String(destruction.worstMilliseconds, 3).paddedLeft(' ', 10) << " ms worst" << std::endl;
+    }
+
+    void runPaint()
+    {
+        SimpleEQAudioProcessor processor;
+        prepare(processor);
+        SimpleEQAudioProcessorEditor editor(processor);
+        auto* curve = findResponseCurve(editor);
+
+        std::cout << std::endl << "Offscreen paint per frame, whole editor and response curve alone" << std::endl;
+        std::cout << juce::String("size").paddedRight(' ', 12) << juce::String("scale").paddedLeft(' ', 6)
+                  << juce::String("pixels").paddedLeft(' ', 12) << juce::String("editor").paddedLeft(' ', 13)
+                  << juce::String("worst").paddedLeft(' ', 13) << juce::String("curve").paddedLeft(' ', 13) << std::endl;
+
+        for (const auto& size : renderSizes)
+        {
+            editor.setSize(size.width, size.height);
+
+            for (const auto scale : scaleFactors)
+            {
+                auto editorImage = makeImage(editor, scale);
+                auto curveImage = makeImage(*curve, scale);
+
+                const auto editorFrame = measure(numPaintFrames, [&](int) { render(editor, editorImage, scale); });
+                const auto curveFrame = measure(numPaintFrames, [&](int) { render(*curve, curveImage, scale); });
+
+                std::cout << (juce::String(size.width) + "x" + juce::String(size.height)).paddedRight(' ', 12)
+                          << juce::String(scale, 1).paddedLeft(' ', 6)
+                          << juce::String(editorImage.getWidth() * editorImage.getHeight()).paddedLeft(' ', 12)
+                          << juce::String(editorFrame.meanMilliseconds, 3).paddedLeft(' ', 10) << " ms"
+                          << juce::String(editorFrame.worstMilliseconds, 3).paddedLeft(' ', 10) << " ms"
+                          << juce::String(curveFrame.meanMilliseconds, 3).paddedLeft(' ', 10) << " ms"
+                          << std::endl;
+            }
+        }
+    }
+
+    struct StormResult
+    {
+        double loadPercentage{ 0 };
+        double dispatchPercentage{ 0 };
+        double paintMilliseconds{ 0 };
+    };
+
+    // numEditors open on one playing processor, each repainted in full every
+    // frame, the worst case, while the message loop runs in between
+    StormResult runStorm(int numEditors, int changesPerBlock)
+    {
+        SimpleEQAudioProcessor processor;
+        prepare(processor);
+
+        std::vector<std::unique_ptr<SimpleEQAudioProcessorEditor>> editors;
+
+        for (int i = 0; i < numEditors; ++i)
+            editors.push_back(std::make_unique<SimpleEQAudioProcessorEditor>(processor));
+
+        auto image = makeImage(*editors.front(), 1.f);
+        auto* messageManager = juce::MessageManager::getInstance();
+
+        // Let the timers and attachments settle before measuring
+        messageManager->runDispatchLoopUntil(100);
+
+        StormResult result;
+        AudioDriver driver(processor, changesPerBlock);
+
+        const auto wallStart = juce::Time::getMillisecondCounterHiRes();
+        const auto cpuStart = getThreadCpuMilliseconds();
+        auto paintMilliseconds = 0.0;
+
+        for (int frame = 0; frame < numStormFrames; ++frame)
+        {
+            const auto frameStart = juce::Time::getMillisecondCounterHiRes();
+
+            for (auto& editor : editors)
+                render(*editor, image, 1.f);
+
+            const auto paintEnd = juce::Time::getMillisecondCounterHiRes();
+            paintMilliseconds += paintEnd - frameStart;
+
+            // Timers, attachment updates and listener callbacks run in here
+            messageManager->runDispatchLoopUntil(juce::jmax(1, (int)(frameStart + frameIntervalMilliseconds - paintEnd)));
+        }
+
+        const auto cpuMilliseconds = getThreadCpuMilliseconds() - cpuStart;
+        const auto wallMilliseconds = juce::Time::getMillisecondCounterHiRes() - wallStart;
+
+        result.loadPercentage = 100.0 * cpuMilliseconds / wallMilliseconds;
+        result.dispatchPercentage = 100.0 * juce::jmax(0.0, cpuMilliseconds - paintMilliseconds) / wallMilliseconds;
+        result.paintMilliseconds = paintMilliseconds / (numStormFrames * numEditors);
+
+        return result;
+    }
+}
+
+int runEditorBenchmark(const juce::StringArray&)
+{
+    runConstruction();
+    runPaint();
+
+    std::cout << std::endl << "Parameter change storms at " << sampleRate << " Hz, block size " << blockSize
+              << ", 1000x600 editors repainted every frame at 60 Hz" << std::endl;
+    std::cout << juce::String("editors").paddedRight(' ', 10) << juce::String("changes/block").paddedLeft(' ', 14)
+              << juce::String("load").paddedLeft(' ', 11) << juce::String("dispatch").paddedLeft(' ', 11)
+              << juce::String("paint").paddedLeft(' ', 13) << std::endl;
+
+    for (const auto numEditors : { 1, 4, 16 })
+    {
+        for (const auto changesPerBlock : { 0, 1, (int)std::size(sliderParameters) })
+        {
+            const auto result = runStorm(numEditors, changesPerBlock);
+
+            std::cout << juce::String(numEditors).paddedRight(' ', 10)
+                      << juce::String(changesPerBlock).paddedLeft(' ', 14)
+                      << juce::String(result.loadPercentage, 1).paddedLeft(' ', 10) << "%"
+                      << juce::String(result.dispatchPercentage, 1).paddedLeft(' ', 10) << "%"
+                      << juce::String(result.paintMilliseconds, 3).paddedLeft(' ', 10) << " ms"
+                      << std::endl;
+        }
+    }
+
+    return 0;
+}
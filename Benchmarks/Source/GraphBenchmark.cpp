@@ -0,0 +1,170 @@
+/*
+  ==============================================================================
+
+    GraphBenchmark.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../SimpleEQ/Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 128;
+    constexpr int numBlocks = 500;
+    constexpr int numWarmUpBlocks = 20;
+
+    // Fraction of instances that get one automated parameter change per block
+    constexpr float automationDensity = 0.25f;
+
+    using Graph = juce::AudioProcessorGraph;
+
+    const char* const automatedParameters[] =
+    {
+        "HighPass Freq",
+        "LowShelf Gain",
+        "Peak 1 Freq",
+        "Peak 2 Gain",
+        "Peak 3 Q",
+        "HighShelf Freq",
+        "LowPass Freq",
+    };
+
+    struct GraphResult
+    {
+        BenchmarkResult block;
+        double buildMilliseconds{ 0 };
+    };
+
+    // N instances either chained one after another, or all fed from the input
+    // and summed into the output
+    GraphResult runScenario(int numInstances, bool serial)
+    {
+        GraphResult result;
+        const auto buildStart = juce::Time::getMillisecondCounterHiRes();
+
+        Graph graph;
+        graph.setPlayConfigDetails(2, 2, sampleRate, blockSize);
+
+        const auto none = Graph::UpdateKind::none;
+        auto input = graph.addNode(std::make_unique<Graph::AudioGraphIOProcessor>(Graph::AudioGraphIOProcessor::audioInputNode), {}, none);
+        auto output = graph.addNode(std::make_unique<Graph::AudioGraphIOProcessor>(Graph::AudioGraphIOProcessor::audioOutputNode), {}, none);
+
+        std::vector<juce::AudioProcessorParameter*> automatable;
+        auto previous = input->nodeID;
+
+        for (int i = 0; i < numInstances; ++i)
+        {
+            auto processor = std::make_unique<SimpleEQAudioProcessor>();
+
+            for (auto* parameterID : automatedParameters)
+                automatable.push_back(processor->apvts.getParameter(parameterID));
+
+            auto node = graph.addNode(std::move(processor), {}, none);
+
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                graph.addConnection({ { serial ? previous : input->nodeID, channel }, { node->nodeID, channel } }, none);
+
+                if (! serial)
+                    graph.addConnection({ { node->nodeID, channel }, { output->nodeID, channel } }, none);
+            }
+
+            previous = node->nodeID;
+        }
+
+        if (serial)
+            for (int channel = 0; channel < 2; ++channel)
+                graph.addConnection({ { previous, channel }, { output->nodeID, channel } }, none);
+
+        graph.prepareToPlay(sampleRate, blockSize);
+        graph.rebuild();
+
+        result.buildMilliseconds = juce::Time::getMillisecondCounterHiRes() - buildStart;
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::MidiBuffer midi;
+        juce::Random random(1234);
+
+        double total = 0;
+        const auto numChanges = juce::jmax(1, juce::roundToInt((float)numInstances * automationDensity));
+
+        for (int block = 0; block < numWarmUpBlocks + numBlocks; ++block)
+        {
+            // Host side automation, outside the timed region
+            for (int i = 0; i < numChanges; ++i)
+                automatable[(size_t)random.nextInt((int)automatable.size())]->setValueNotifyingHost(random.nextFloat());
+
+            fillWithNoise(buffer, random);
+
+            const auto start = juce::Time::getMillisecondCounterHiRes();
+            graph.processBlock(buffer, midi);
+            const auto elapsed = juce::Time::getMillisecondCounterHiRes() - start;
+
+            if (block < numWarmUpBlocks)
+                continue;
+
+            total += elapsed;
+            result.block.worstMilliseconds = juce::jmax(result.block.worstMilliseconds, elapsed);
+        }
+
+        result.block.meanMilliseconds = total / numBlocks;
+        graph.releaseResources();
+
+        return result;
+    }
+}
+
+int runGraphBenchmark(const juce::StringArray& args)
+{
+    // graph [serial|parallel] [maximum instances]
+    const auto topology = args.contains("serial") ? juce::String("serial") : args.contains("parallel") ? juce::String("parallel") : juce::String();
+    auto maxInstances = 1000;
+
+    for (const auto& arg : args)
+        if (arg.isNotEmpty() && arg.containsOnly("0123456789"))
+            maxInstances = juce::jmax(1, arg.getIntValue());
+
+    std::cout << "Block size " << blockSize << " at " << sampleRate << " Hz, "
+              << numBlocks << " blocks, " << sizeof(SimpleEQAudioProcessor) << " B per processor object" << std::endl;
+    std::cout << juce::String("topology").paddedRight(' ', 10) << juce::String("N").paddedLeft(' ', 6)
+              << "     build" << "      mean" << "     worst" << "  per inst" << "  vs N=1" << "  worst/rt" << std::endl;
+
+    for (auto serial : { true, false })
+    {
+        if (topology.isNotEmpty() && topology != (serial ? "serial" : "parallel"))
+            continue;
+
+        // Per instance cost growing with N points at cache misses once the
+        // instances' state no longer fits
+        double singleInstanceCost = 0;
+
+        for (auto numInstances : { 1, 10, 50, 100, 250, 500, 1000 })
+        {
+            if (numInstances > maxInstances)
+                break;
+
+            const auto result = runScenario(numInstances, serial);
+            const auto perInstance = result.block.meanMilliseconds / numInstances;
+
+            if (numInstances == 1)
+                singleInstanceCost = perInstance;
+
+            std::cout << juce::String(serial ? "serial" : "parallel").paddedRight(' ', 10)
+                      << juce::String(numInstances).paddedLeft(' ', 6)
+                      << juce::String(result.buildMilliseconds, 0).paddedLeft(' ', 7) << " ms"
+                      << juce::String(result.block.meanMilliseconds * 1000.0, 1).paddedLeft(' ', 7) << " us"
+                      << juce::String(result.block.worstMilliseconds * 1000.0, 1).paddedLeft(' ', 7) << " us"
+                      << juce::String(perInstance * 1000.0, 2).paddedLeft(' ', 7) << " us"
+                      << juce::String(singleInstanceCost > 0 ? perInstance / singleInstanceCost : 0.0, 2).paddedLeft(' ', 7) << "x"
+                      << juce::String(getRealtimePercentage(result.block.worstMilliseconds, blockSize, sampleRate), 1).paddedLeft(' ', 8) << " %"
+                      << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    LoudnessBenchmark.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../SimpleEQ/Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 128;
+    constexpr int numBlocks = 8000;
+
+    BenchmarkResult runScenario(bool meter, bool autoGain, SimpleEQAudioProcessor& processor)
+    {
+        processor.setPlayConfigDetails(2, 2, sampleRate, blockSize);
+
+        setParameter(processor.apvts, "LowShelf Gain", 6.f);
+        setParameter(processor.apvts, "Peak 2 Gain", 4.f);
+        setParameter(processor.apvts, "Loudness Meter", meter ? 1.f : 0.f);
+        setParameter(processor.apvts, "Auto Gain", autoGain ? 1.f : 0.f);
+
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::MidiBuffer midi;
+        juce::Random random(1234);
+
+        return measure(numBlocks, [&](int)
+        {
+            fillWithNoise(buffer, random);
+            processor.processBlock(buffer, midi);
+        });
+    }
+}
+
+int runLoudnessBenchmark(const juce::StringArray&)
+{
+    std::cout << "Block size " << blockSize << " at " << sampleRate << " Hz, "
+              << numBlocks * blockSize / sampleRate << " s of noise" << std::endl;
+    std::cout << juce::String("scenario").paddedRight(' ', 16) << "      mean" << "     worst"
+              << "   in LUFS" << "  out LUFS" << "   gain dB" << std::endl;
+
+    const struct { const char* name; bool meter, autoGain; } scenarios[] =
+    {
+        { "off", false, false },
+        { "meter", true, false },
+        { "meter + gain", true, true },
+    };
+
+    for (const auto& scenario : scenarios)
+    {
+        SimpleEQAudioProcessor processor;
+        const auto result = runScenario(scenario.meter, scenario.autoGain, processor);
+
+        // Give the analysis thread a moment to catch up before reading the meters
+        juce::Thread::sleep(100);
+
+        std::cout << juce::String(scenario.name).paddedRight(' ', 16)
+                  << juce::String(result.meanMilliseconds * 1000.0, 2).paddedLeft(' ', 10) << " us"
+                  << juce::String(result.worstMilliseconds * 1000.0, 2).paddedLeft(' ', 10) << " us"
+                  << juce::String(processor.getInputMeter().getIntegratedLoudness(), 1).paddedLeft(' ', 10)
+                  << juce::String(processor.getOutputMeter().getIntegratedLoudness(), 1).paddedLeft(' ', 10)
+                  << juce::String(processor.getAutoGainInDecibels(), 1).paddedLeft(' ', 10)
+                  << std::endl;
+    }
+
+    return 0;
+}
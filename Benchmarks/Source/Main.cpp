@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "Benchmarks.h"
+
+namespace
+{
+    struct Suite
+    {
+        const char* name;
+        const char* description;
+        int (*run)(const juce::StringArray&);
+    };
+
+    const Suite suites[] =
+    {
+        { "automation", "processBlock cost with sample-accurate and smoothed automation", runAutomationBenchmark },
+        { "block-biquad", "BlockBiquad equivalence with IIR::Filter and chain throughput", runBlockBiquadBenchmark },
+        { "dynamics", "processBlock cost of dynamic bands against a static EQ", runDynamicsBenchmark },
+        { "loudness", "processBlock cost of the loudness meters and auto gain", runLoudnessBenchmark },
+        { "state", "State save/restore, legacy ValueTree against binary, and preset bank recall", runStateBenchmark },
+        { "graph", "Per-instance cost of N processors in an AudioProcessorGraph, serial and parallel", runGraphBenchmark },
+        { "response", "Batch frequency response QA across sample rates, of random presets or a bank", runResponseBenchmark },
+        { "match", "Match EQ spectrum capture and band fit against a known curve", runMatchBenchmark },
+        { "oversampling", "processBlock cost of selective oversampling against the full chain", runOversamplingBenchmark },
+        { "crossover", "Linkwitz-Riley band split cost against one EQ instance per band", runCrossoverBenchmark },
+        { "coefficients", "Band design cost and accuracy, trigonometry against the coefficient tables", runCoefficientBenchmark },
+        { "editor", "Editor construction, offscreen paint at several sizes and scales, message thread load under parameter storms", runEditorBenchmark },
+    };
+
+    void printUsage()
+    {
+        std::cout << "Usage: SimpleEQBenchmarks <suite> [options]" << std::endl << std::endl;
+
+        for (const auto& suite : suites)
+            std::cout << "  " << suite.name << "\t" << suite.description << std::endl;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    // The processor and its parameters expect a message manager to exist
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(argv[i]);
+
+    if (args.isEmpty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    for (const auto& suite : suites)
+        if (args[0] == suite.name)
+            return suite.run(juce::StringArray(args.begin() + 1, args.size() - 1));
+
+    printUsage();
+    return 1;
+}
@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+    MatchBenchmark.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../SimpleEQ/Source/MatchEq.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+    constexpr int numCaptureBlocks = 1000;      // about 10 seconds
+
+    // Noise through a chain designed from settings, into one analyzer slot
+    int capture(SpectrumAnalyzer& analyzer, SpectrumAnalyzer::Slot slot, const ChainSettings& settings, juce::Random& random)
+    {
+        MonoChain chain;
+        chain.prepare({ sampleRate, (juce::uint32)blockSize, 1 });
+        applyChainCoefficients(chain, makeChainCoefficients(settings, sampleRate));
+
+        juce::AudioBuffer<float> buffer(1, blockSize);
+        analyzer.startCapture(slot);
+
+        for (int i = 0; i < numCaptureBlocks; ++i)
+        {
+            fillWithNoise(buffer, random);
+
+            juce::dsp::AudioBlock<float> block(buffer);
+            chain.process(juce::dsp::ProcessContextReplacing<float>(block));
+
+            // Don't outrun the analysis thread, nothing should be dropped
+            while (analyzer.getNumPending() > 8192)
+                juce::Thread::sleep(1);
+
+            analyzer.push(block);
+        }
+
+        while (analyzer.getNumPending() >= SpectrumAnalyzer::fftSize / 4)
+            juce::Thread::sleep(1);
+
+        analyzer.stopCapture();
+
+        std::vector<float> power;
+        return analyzer.getAverageSpectrum(slot, power);
+    }
+
+    void printBands(const juce::String& name, const ChainSettings& s)
+    {
+        std::cout << name.paddedRight(' ', 8)
+                  << "low shelf " << juce::String(s.lowShelfFreq, 0) << " Hz " << juce::String(s.lowShelfGainInDecibels, 1) << " dB, peaks";
+
+        for (int i = 0; i < 3; ++i)
+            std::cout << " " << juce::String(s.peakFreq[i], 0) << " Hz " << juce::String(s.peakGainInDecibels[i], 1)
+                      << " dB Q " << juce::String(s.peakQ[i], 2) << (i < 2 ? "," : "");
+
+        std::cout << ", high shelf " << juce::String(s.highShelfFreq, 0) << " Hz " << juce::String(s.highShelfGainInDecibels, 1) << " dB"
+                  << std::endl;
+    }
+}
+
+int runMatchBenchmark(const juce::StringArray&)
+{
+    // The default parameter values: flat, cuts wide open
+    SimpleEQAudioProcessor processor;
+    const auto flat = getChainSettings(processor.apvts);
+
+    auto curve = flat;
+    curve.lowShelfFreq = 120.f;
+    curve.lowShelfGainInDecibels = 4.f;
+    curve.peakFreq[0] = 450.f;
+    curve.peakGainInDecibels[0] = -5.f;
+    curve.peakQ[0] = 1.2f;
+    curve.peakFreq[1] = 2500.f;
+    curve.peakGainInDecibels[1] = 3.f;
+    curve.peakQ[1] = 2.f;
+    curve.highShelfFreq = 9000.f;
+    curve.highShelfGainInDecibels = -6.f;
+
+    SpectrumAnalyzer analyzer;
+    analyzer.prepare(sampleRate);
+    juce::Random random(1234);
+
+    // The reference is noise with the curve applied, the material plain noise
+    const auto start = juce::Time::getMillisecondCounterHiRes();
+    const auto referenceFrames = capture(analyzer, SpectrumAnalyzer::Slot_Reference, curve, random);
+    const auto currentFrames = capture(analyzer, SpectrumAnalyzer::Slot_Current, flat, random);
+
+    std::cout << "Captured " << referenceFrames << " and " << currentFrames << " FFT frames of "
+              << SpectrumAnalyzer::fftSize << " in " << juce::String(juce::Time::getMillisecondCounterHiRes() - start, 0)
+              << " ms" << std::endl;
+
+    std::vector<float> reference, current;
+    analyzer.getAverageSpectrum(SpectrumAnalyzer::Slot_Reference, reference);
+    analyzer.getAverageSpectrum(SpectrumAnalyzer::Slot_Current, current);
+
+    const auto grid = FrequencyGrid::logarithmic(MatchEqFitter::numGridPoints, 20.0, 20000.0, sampleRate);
+    const auto target = makeMatchTarget(reference, current, SpectrumAnalyzer::fftSize, grid);
+
+    MatchResult result;
+    const auto fit = measure(10, [&](int) { result = fitMatchEq(target, grid, flat); });
+
+    std::cout << "Fit: " << result.numIterations << " iterations, mean " << juce::String(fit.meanMilliseconds, 1)
+              << " ms, worst " << juce::String(fit.worstMilliseconds, 1) << " ms, rms error "
+              << juce::String(result.rmsErrorInDecibels, 2) << " dB" << std::endl;
+
+    printBands("target", curve);
+    printBands("fitted", result.settings);
+
+    // The same through the processor's background fitter
+    MatchEqFitter fitter;
+    const auto threadStart = juce::Time::getMillisecondCounterHiRes();
+    fitter.start(reference, current, SpectrumAnalyzer::fftSize, sampleRate, flat);
+
+    std::optional<MatchResult> threaded;
+
+    while (! (threaded = fitter.takeResult()).has_value())
+        juce::Thread::sleep(1);
+
+    std::cout << "Background fit delivered after " << juce::String(juce::Time::getMillisecondCounterHiRes() - threadStart, 1)
+              << " ms" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+    OversamplingBenchmark.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../SimpleEQ/Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 128;
+    constexpr int numBlocks = 4000;
+
+    struct Scenario
+    {
+        const char* name;
+        OversamplingMode mode;
+        int filter;
+    };
+
+    const Scenario scenarios[] =
+    {
+        { "off", OversamplingMode::Oversampling_Off, 0 },
+        { "2x selective IIR", OversamplingMode::Oversampling_2xSelective, 0 },
+        { "2x full IIR", OversamplingMode::Oversampling_2xFull, 0 },
+        { "4x selective IIR", OversamplingMode::Oversampling_4xSelective, 0 },
+        { "4x full IIR", OversamplingMode::Oversampling_4xFull, 0 },
+        { "2x selective FIR", OversamplingMode::Oversampling_2xSelective, 1 },
+        { "2x full FIR", OversamplingMode::Oversampling_2xFull, 1 },
+        { "4x selective FIR", OversamplingMode::Oversampling_4xSelective, 1 },
+        { "4x full FIR", OversamplingMode::Oversampling_4xFull, 1 },
+    };
+
+    struct ScenarioResult
+    {
+        BenchmarkResult timing;
+        int latencyInSamples{ 0 };
+    };
+
+    ScenarioResult runScenario(const Scenario& scenario)
+    {
+        SimpleEQAudioProcessor processor;
+        processor.setPlayConfigDetails(2, 2, sampleRate, blockSize);
+
+        // A full chain where only Peak 3 and the low pass sit above the threshold
+        setParameter(processor.apvts, "HighPass Freq", 30.f);
+        setParameter(processor.apvts, "HighPass Slope", 1.f);
+        setParameter(processor.apvts, "LowShelf Gain", 3.f);
+        setParameter(processor.apvts, "Peak 1 Freq", 250.f);
+        setParameter(processor.apvts, "Peak 1 Gain", -4.f);
+        setParameter(processor.apvts, "Peak 2 Freq", 2500.f);
+        setParameter(processor.apvts, "Peak 2 Gain", 3.f);
+        setParameter(processor.apvts, "Peak 3 Freq", 16000.f);
+        setParameter(processor.apvts, "Peak 3 Gain", 6.f);
+        setParameter(processor.apvts, "Peak 3 Q", 4.f);
+        setParameter(processor.apvts, "HighShelf Gain", -2.f);
+        setParameter(processor.apvts, "LowPass Freq", 18000.f);
+        setParameter(processor.apvts, "LowPass Slope", 3.f);
+
+        setParameter(processor.apvts, "Oversampling", (float)scenario.mode);
+        setParameter(processor.apvts, "Oversampling Filter", (float)scenario.filter);
+
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::MidiBuffer midi;
+        juce::Random random(1234);
+
+        ScenarioResult result;
+        result.timing = measure(numBlocks, [&](int)
+        {
+            fillWithNoise(buffer, random);
+            processor.processBlock(buffer, midi);
+        });
+        result.latencyInSamples = processor.getLatencySamples();
+
+        return result;
+    }
+}
+
+int runOversamplingBenchmark(const juce::StringArray&)
+{
+    std::cout << "Block size " << blockSize << " at " << sampleRate << " Hz, 2 of 7 bands above "
+              << "the selective threshold" << std::endl;
+    std::cout << juce::String("mode").paddedRight(' ', 20) << "      mean" << "     worst" << "    vs off"
+              << "  vs full" << "   latency" << std::endl;
+
+    std::vector<ScenarioResult> results;
+
+    for (const auto& scenario : scenarios)
+        results.push_back(runScenario(scenario));
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& result = results[i];
+        const auto& off = results.front().timing;
+
+        // Each selective row is followed by the full row at the same factor and filter
+        const auto selective = scenarios[i].mode == OversamplingMode::Oversampling_2xSelective
+                            || scenarios[i].mode == OversamplingMode::Oversampling_4xSelective;
+        const auto versusFull = selective ? juce::String(result.timing.meanMilliseconds / results[i + 1].timing.meanMilliseconds, 2) + " x"
+                                          : juce::String("-");
+
+        std::cout << juce::String(scenarios[i].name).paddedRight(' ', 20)
+                  << juce::String(result.timing.meanMilliseconds * 1000.0, 2).paddedLeft(' ', 10) << " us"
+                  << juce::String(result.timing.worstMilliseconds * 1000.0, 2).paddedLeft(' ', 10) << " us"
+                  << juce::String(result.timing.meanMilliseconds / off.meanMilliseconds, 2).paddedLeft(' ', 7) << " x"
+                  << versusFull.paddedLeft(' ', 9)
+                  << juce::String(result.latencyInSamples).paddedLeft(' ', 7) << " samples"
+                  << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,205 @@
+/*
+  ==============================================================================
+
+    ResponseBenchmark.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../SimpleEQ/Source/FrequencyResponse.h"
+
+namespace
+{
+    constexpr int numRandomPresets = 10000;
+    constexpr int numGridPoints = 512;
+    constexpr int numReferencePresets = 100;
+
+    float randomFrequency(juce::Random& random)
+    {
+        return (float)juce::mapToLog10((double)random.nextFloat(), 20.0, 20000.0);
+    }
+
+    ChainSettings makeRandomPreset(juce::Random& random)
+    {
+        ChainSettings settings;
+
+        settings.highPassFreq = randomFrequency(random);
+        settings.lowPassFreq = randomFrequency(random);
+        settings.highPassSlope = static_cast<Slope>(random.nextInt(4));
+        settings.lowPassSlope = static_cast<Slope>(random.nextInt(4));
+        settings.lowShelfFreq = randomFrequency(random);
+        settings.lowShelfGainInDecibels = random.nextFloat() * 48.f - 24.f;
+        settings.lowShelfQ = 0.1f + random.nextFloat() * 4.9f;
+        settings.highShelfFreq = randomFrequency(random);
+        settings.highShelfGainInDecibels = random.nextFloat() * 48.f - 24.f;
+        settings.highShelfQ = 0.1f + random.nextFloat() * 4.9f;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            settings.peakFreq[i] = randomFrequency(random);
+            settings.peakGainInDecibels[i] = random.nextFloat() * 48.f - 24.f;
+            settings.peakQ[i] = 0.1f + random.nextFloat() * 9.9f;
+        }
+
+        return settings;
+    }
+
+    // The editor's original approach, one IIR::Coefficients call per section and frequency
+    double getReferenceMagnitudeInDecibels(const ChainCoefficients& coefficients, double frequency, double sampleRate)
+    {
+        double magnitude = 1.0;
+
+        const auto multiply = [&](const CoefficientArray& c)
+        {
+            const juce::dsp::IIR::Coefficients<float> section(c[0], c[1], c[2], c[3], c[4], c[5]);
+            magnitude *= section.getMagnitudeForFrequency(frequency, sampleRate);
+        };
+
+        for (int i = 0; i < coefficients.numHighPassSections; ++i)
+            multiply(coefficients.highPass[(size_t)i]);
+
+        multiply(coefficients.lowShelf);
+
+        for (const auto& peak : coefficients.peaks)
+            multiply(peak);
+
+        multiply(coefficients.highShelf);
+
+        for (int i = 0; i < coefficients.numLowPassSections; ++i)
+            multiply(coefficients.lowPass[(size_t)i]);
+
+        return juce::Decibels::gainToDecibels(magnitude, -600.0);
+    }
+}
+
+int runResponseBenchmark(const juce::StringArray& args)
+{
+    // response [preset bank]: QA of a bank, or of random presets without one
+    std::vector<ChainSettings> presets;
+    juce::StringArray names;
+
+    if (args.size() > 0)
+    {
+        PresetBank bank(juce::File::getCurrentWorkingDirectory().getChildFile(args[0]));
+
+        if (! bank.isValid())
+        {
+            std::cout << "Can't open preset bank " << args[0] << std::endl;
+            return 1;
+        }
+
+        SimpleEQAudioProcessor processor;
+
+        for (int i = 0; i < bank.getNumPresets(); ++i)
+        {
+            processor.loadPreset(bank, i);
+            presets.push_back(getChainSettings(processor.apvts));
+            names.add(juce::String::fromUTF8(bank.getName(i)));
+        }
+    }
+    else
+    {
+        juce::Random random(1234);
+
+        for (int i = 0; i < numRandomPresets; ++i)
+        {
+            presets.push_back(makeRandomPreset(random));
+            names.add("random " + juce::String(i));
+        }
+    }
+
+    const ResponseLimits limits;
+    std::cout << presets.size() << " presets, " << numGridPoints << " log-spaced points from 20 Hz to 20 kHz, "
+              << juce::SystemStats::getNumCpus() << " cores" << std::endl;
+
+    // Accuracy and speed against per-point IIR::Coefficients calls
+    {
+        const auto grid = FrequencyGrid::logarithmic(numGridPoints, 20.0, 20000.0, 48000.0);
+        const auto numReference = std::min(presets.size(), (size_t)numReferencePresets);
+        FrequencyResponse response;
+        double worstError = 0, sink = 0;
+
+        const auto batch = measure((int)numReference, [&](int i)
+        {
+            computeFrequencyResponse(makeChainCoefficients(presets[(size_t)i], grid.getSampleRate()), grid, response);
+        });
+
+        const auto reference = measure((int)numReference, [&](int i)
+        {
+            const auto coefficients = makeChainCoefficients(presets[(size_t)i], grid.getSampleRate());
+
+            for (auto frequency : grid.getFrequencies())
+                sink += getReferenceMagnitudeInDecibels(coefficients, frequency, grid.getSampleRate());
+        });
+
+        for (size_t i = 0; i < numReference; ++i)
+        {
+            const auto coefficients = makeChainCoefficients(presets[i], grid.getSampleRate());
+            computeFrequencyResponse(coefficients, grid, response);
+
+            for (size_t k = 0; k < grid.size(); ++k)
+            {
+                const auto expected = getReferenceMagnitudeInDecibels(coefficients, grid.getFrequencies()[k], grid.getSampleRate());
+
+                // Deep in a cut filter's stop band both are only rounding noise
+                if (expected > -120.0)
+                    worstError = juce::jmax(worstError, std::abs(expected - response.magnitudeInDecibels[k]));
+            }
+        }
+
+        std::cout << "Per preset at 48 kHz: " << juce::String(batch.meanMilliseconds * 1000.0, 1)
+                  << " us with phase and group delay, " << juce::String(reference.meanMilliseconds * 1000.0, 1)
+                  << " us magnitude only through IIR::Coefficients, worst difference "
+                  << juce::String(worstError, 4) << " dB" << std::endl;
+
+        juce::ignoreUnused(sink);
+    }
+
+    std::cout << juce::String("sample rate").paddedRight(' ', 14) << "  1 thread" << "  all cores"
+              << "   presets/s" << "  clip" << "  limit" << "  unstable" << std::endl;
+
+    std::vector<ResponseCheck> checks;
+
+    for (auto sampleRate : { 44100.0, 48000.0, 96000.0, 192000.0 })
+    {
+        const auto grid = FrequencyGrid::logarithmic(numGridPoints, 20.0, 20000.0, sampleRate);
+
+        const auto single = measure(1, [&](int) { checks = analyseFrequencyResponses(presets, grid, limits, nullptr, 1); });
+        const auto parallel = measure(1, [&](int) { checks = analyseFrequencyResponses(presets, grid, limits); });
+
+        const auto count = [&checks](auto predicate)
+        {
+            return (int)std::count_if(checks.begin(), checks.end(), predicate);
+        };
+
+        std::cout << (juce::String(sampleRate, 0) + " Hz").paddedRight(' ', 14)
+                  << juce::String(single.meanMilliseconds, 1).paddedLeft(' ', 7) << " ms"
+                  << juce::String(parallel.meanMilliseconds, 1).paddedLeft(' ', 8) << " ms"
+                  << juce::String(presets.size() / (parallel.meanMilliseconds * 0.001), 0).paddedLeft(' ', 12)
+                  << juce::String(count([](const ResponseCheck& c) { return c.clips; })).paddedLeft(' ', 6)
+                  << juce::String(count([](const ResponseCheck& c) { return c.exceedsGainLimit; })).paddedLeft(' ', 7)
+                  << juce::String(count([](const ResponseCheck& c) { return c.unstable; })).paddedLeft(' ', 10)
+                  << std::endl;
+    }
+
+    // The last sweep's failures, for a bank
+    if (args.size() > 0)
+    {
+        for (size_t i = 0; i < checks.size(); ++i)
+        {
+            if (checks[i].passes())
+                continue;
+
+            std::cout << names[(int)i] << ": peak " << juce::String(checks[i].peakGainInDecibels, 1) << " dB at "
+                      << juce::String(checks[i].peakFrequency, 0) << " Hz"
+                      << (checks[i].clips ? ", clips" : "")
+                      << (checks[i].exceedsGainLimit ? ", over the gain limit" : "")
+                      << (checks[i].unstable ? ", unstable" : "") << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    StateBenchmark.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../SimpleEQ/Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr int numIterations = 2000;
+    constexpr int numPresets = 5000;
+
+    // Every band parameter somewhere random, so restoring really changes things
+    void randomise(SimpleEQAudioProcessor& processor, juce::Random& random)
+    {
+        for (auto* parameter : processor.getParameters())
+            parameter->setValueNotifyingHost(random.nextFloat());
+    }
+
+    void report(const juce::String& name, const BenchmarkResult& result, size_t bytes)
+    {
+        std::cout << name.paddedRight(' ', 28)
+                  << juce::String(result.meanMilliseconds * 1000.0, 2).paddedLeft(' ', 10) << " us"
+                  << juce::String(result.worstMilliseconds * 1000.0, 2).paddedLeft(' ', 10) << " us"
+                  << juce::String((juce::int64)bytes).paddedLeft(' ', 10) << " B"
+                  << std::endl;
+    }
+}
+
+int runStateBenchmark(const juce::StringArray&)
+{
+    SimpleEQAudioProcessor processor;
+    juce::Random random(1234);
+
+    // Alternate between two states so every restore has work to do
+    std::array<juce::MemoryBlock, 2> legacy, binary;
+
+    for (size_t i = 0; i < 2; ++i)
+    {
+        randomise(processor, random);
+
+        juce::MemoryOutputStream stream(legacy[i], false);
+        processor.apvts.copyState().writeToStream(stream);
+        stream.flush();
+
+        processor.getStateInformation(binary[i]);
+    }
+
+    std::cout << processor.getParameters().size() << " parameters" << std::endl;
+    std::cout << juce::String("scenario").paddedRight(' ', 28) << "      mean" << "     worst" << "      size" << std::endl;
+
+    report("legacy ValueTree restore", measure(numIterations, [&](int i)
+    {
+        processor.setStateInformation(legacy[(size_t)(i % 2)].getData(), (int)legacy[(size_t)(i % 2)].getSize());
+    }), legacy[0].getSize());
+
+    report("binary restore", measure(numIterations, [&](int i)
+    {
+        processor.setStateInformation(binary[(size_t)(i % 2)].getData(), (int)binary[(size_t)(i % 2)].getSize());
+    }), binary[0].getSize());
+
+    // Measured first, the size is only known afterwards
+    juce::MemoryBlock saved;
+    const auto save = measure(numIterations, [&](int)
+    {
+        processor.getStateInformation(saved);
+    });
+    report("binary save", save, saved.getSize());
+
+    // A bank of random presets, written once, then opened and browsed
+    std::vector<PresetBank::Preset> presets((size_t)numPresets);
+
+    for (int i = 0; i < numPresets; ++i)
+    {
+        randomise(processor, random);
+        presets[(size_t)i].name = "Preset " + juce::String(i);
+        processor.getStateInformation(presets[(size_t)i].state);
+    }
+
+    const juce::TemporaryFile bankFile(".seqbank");
+    PresetBank::write(bankFile.getFile(), presets);
+
+    std::unique_ptr<PresetBank> bank;
+    report("bank open", measure(1, [&](int)
+    {
+        bank = std::make_unique<PresetBank>(bankFile.getFile());
+    }), (size_t)bankFile.getFile().getSize());
+
+    if (! bank->isValid() || bank->getNumPresets() != numPresets)
+    {
+        std::cout << "FAILED: bank didn't read back" << std::endl;
+        return 1;
+    }
+
+    size_t nameBytes = 0;
+    const auto browse = measure(1, [&](int)
+    {
+        for (int i = 0; i < bank->getNumPresets(); ++i)
+            nameBytes += std::strlen(bank->getName(i));
+    });
+    report("bank browse all names", browse, nameBytes);
+
+    report("bank recall", measure(numIterations, [&](int)
+    {
+        processor.loadPreset(*bank, random.nextInt(numPresets));
+    }), binary[0].getSize());
+
+    return 0;
+}
@@ -0,0 +1,29 @@
+/*
+  ==============================================================================
+
+    AnalysisThread.h
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// One background thread for all the meters and analyzers of every instance in
+// the process. Clients hold a juce::SharedResourcePointer<AnalysisThread>,
+// which keeps it running while any of them exist.
+struct AnalysisThread : juce::TimeSliceThread
+{
+    AnalysisThread() : juce::TimeSliceThread("Analysis")
+    {
+        startThread();
+    }
+
+    ~AnalysisThread() override
+    {
+        stopThread(2000);
+    }
+};
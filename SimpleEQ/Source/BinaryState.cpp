@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    BinaryState.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "BinaryState.h"
+
+namespace
+{
+    float readLittleEndianFloat(const char* bytes) noexcept
+    {
+        const auto bits = juce::ByteOrder::littleEndianInt(bytes);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+}
+
+void writeBinaryState(const juce::Array<juce::AudioProcessorParameter*>& parameters, juce::MemoryBlock& destData)
+{
+    juce::MemoryOutputStream stream(destData, false);
+    stream.preallocate((size_t)(binaryStateHeaderSize + parameters.size() * 4));
+
+    stream.writeInt((int)binaryStateMagic);
+    stream.writeInt((int)binaryStateVersion);
+    stream.writeInt(parameters.size());
+
+    for (auto* parameter : parameters)
+    {
+        // Plain units, so a later range change doesn't move stored settings
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+            stream.writeFloat(ranged->convertFrom0to1(ranged->getValue()));
+        else
+            stream.writeFloat(parameter->getValue());
+    }
+}
+
+bool isBinaryState(const void* data, int sizeInBytes)
+{
+    return data != nullptr
+        && sizeInBytes >= binaryStateHeaderSize
+        && juce::ByteOrder::littleEndianInt(data) == binaryStateMagic;
+}
+
+bool readBinaryState(const void* data, int sizeInBytes, const juce::Array<juce::AudioProcessorParameter*>& parameters)
+{
+    if (! isBinaryState(data, sizeInBytes))
+        return false;
+
+    const auto* bytes = static_cast<const char*>(data);
+    const auto version = juce::ByteOrder::littleEndianInt(bytes + 4);
+    const auto numValues = (int)juce::ByteOrder::littleEndianInt(bytes + 8);
+
+    if (version > binaryStateVersion || numValues < 0 || numValues > (sizeInBytes - binaryStateHeaderSize) / 4)
+        return false;
+
+    const auto* values = bytes + binaryStateHeaderSize;
+
+    for (int i = 0; i < juce::jmin(numValues, parameters.size()); ++i)
+    {
+        auto* parameter = parameters[i];
+        const auto value = readLittleEndianFloat(values + i * 4);
+
+        auto normalised = value;
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+            normalised = ranged->convertTo0to1(value);
+
+        // Unchanged parameters skip the listener callbacks
+        if (parameter->getValue() != normalised)
+            parameter->setValueNotifyingHost(normalised);
+    }
+
+    return true;
+}
@@ -0,0 +1,29 @@
+/*
+  ==============================================================================
+
+    BinaryState.h
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Fixed-layout plugin state: a 12 byte header (magic, version, value count as
+// little-endian uint32) followed by the plain value of every parameter as a
+// little-endian float, in getParameters() order. Parameters are only ever
+// appended to the layout, so an older state simply leaves the newer ones alone.
+constexpr juce::uint32 binaryStateMagic = 0x53514553;  // "SEQS"
+constexpr juce::uint32 binaryStateVersion = 1;
+constexpr int binaryStateHeaderSize = 12;
+
+void writeBinaryState(const juce::Array<juce::AudioProcessorParameter*>& parameters, juce::MemoryBlock& destData);
+
+bool isBinaryState(const void* data, int sizeInBytes);
+
+// Sets every parameter the state holds a value for. Returns false, changing
+// nothing, if the data isn't a binary state this version can read.
+bool readBinaryState(const void* data, int sizeInBytes, const juce::Array<juce::AudioProcessorParameter*>& parameters);
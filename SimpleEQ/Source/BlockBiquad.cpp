@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+    BlockBiquad.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "BlockBiquad.h"
+
+BlockBiquad::BlockBiquad()
+    : coefficients(new juce::dsp::IIR::Coefficients<float>(1, 0, 0, 1, 0, 0))
+{
+    current = { 1.f, 0.f, 0.f, 0.f, 0.f };
+    updateLookAhead();
+}
+
+void BlockBiquad::prepare(const juce::dsp::ProcessSpec& spec) noexcept
+{
+    jassert(spec.numChannels == 1);
+    juce::ignoreUnused(spec);
+
+    reset();
+}
+
+void BlockBiquad::reset() noexcept
+{
+    s1 = 0.f;
+    s2 = 0.f;
+}
+
+void BlockBiquad::snapToZero() noexcept
+{
+    juce::dsp::util::snapToZero(s1);
+    juce::dsp::util::snapToZero(s2);
+}
+
+void BlockBiquad::updateLookAhead() noexcept
+{
+    const double b0 = current[0], b1 = current[1], b2 = current[2], a1 = current[3], a2 = current[4];
+    constexpr auto numBasis = blockLength + 2;
+
+    // Run the recursion symbolically: every quantity is a vector of weights over
+    // the basis (s1, s2, x[0] ... x[blockLength - 1]). Done in double, stored as float.
+    std::array<double, numBasis> state1{}, state2{};
+    state1[0] = 1.0;
+    state2[1] = 1.0;
+
+    for (size_t k = 0; k < blockLength; ++k)
+    {
+        std::array<double, numBasis> y = state1;
+        y[2 + k] += b0;
+
+        for (size_t j = 0; j < numBasis; ++j)
+        {
+            outputColumns[j][k] = (float)y[j];
+
+            const auto next1 = -a1 * y[j] + state2[j];
+            const auto next2 = -a2 * y[j];
+
+            state1[j] = next1;
+            state2[j] = next2;
+        }
+
+        state1[2 + k] += b1;
+        state2[2 + k] += b2;
+    }
+
+    for (size_t j = 0; j < numBasis; ++j)
+    {
+        stateRows[0][j] = (float)state1[j];
+        stateRows[1][j] = (float)state2[j];
+    }
+}
+
+void BlockBiquad::processSamples(const float* input, float* output, size_t numSamples) noexcept
+{
+    // Pick up in-place coefficient changes
+    {
+        const auto* raw = coefficients->getRawCoefficients();
+        const auto order = coefficients->getFilterOrder();
+
+        std::array<float, 5> latest{};
+
+        if (order == 2)
+            latest = { raw[0], raw[1], raw[2], raw[3], raw[4] };
+        else if (order == 1)
+            latest = { raw[0], raw[1], 0.f, raw[2], 0.f };
+        else
+            latest = { raw[0], 0.f, 0.f, 0.f, 0.f };
+
+        if (latest != current)
+        {
+            current = latest;
+            updateLookAhead();
+        }
+    }
+
+    size_t i = 0;
+
+    for (; i + blockLength <= numSamples; i += blockLength)
+    {
+        // Copy first, output may alias input
+        float x[blockLength];
+        for (size_t k = 0; k < blockLength; ++k)
+            x[k] = input[i + k];
+
+        alignas(32) float y[blockLength];
+
+       #if JUCE_USE_SIMD
+        using Vec = juce::dsp::SIMDRegister<float>;
+
+        auto acc = Vec::fromRawArray(outputColumns[0]) * s1
+                 + Vec::fromRawArray(outputColumns[1]) * s2;
+
+        for (size_t k = 0; k < blockLength; ++k)
+            acc += Vec::fromRawArray(outputColumns[2 + k]) * x[k];
+
+        acc.copyToRawArray(y);
+       #else
+        for (size_t lane = 0; lane < blockLength; ++lane)
+        {
+            auto acc = outputColumns[0][lane] * s1 + outputColumns[1][lane] * s2;
+
+            for (size_t k = 0; k < blockLength; ++k)
+                acc += outputColumns[2 + k][lane] * x[k];
+
+            y[lane] = acc;
+        }
+       #endif
+
+        auto next1 = stateRows[0][0] * s1 + stateRows[0][1] * s2;
+        auto next2 = stateRows[1][0] * s1 + stateRows[1][1] * s2;
+
+        for (size_t k = 0; k < blockLength; ++k)
+        {
+            next1 += stateRows[0][2 + k] * x[k];
+            next2 += stateRows[1][2 + k] * x[k];
+        }
+
+        s1 = next1;
+        s2 = next2;
+
+        for (size_t k = 0; k < blockLength; ++k)
+            output[i + k] = y[k];
+    }
+
+    // Remaining samples, plain transposed direct form II
+    const auto b0 = current[0], b1 = current[1], b2 = current[2], a1 = current[3], a2 = current[4];
+
+    for (; i < numSamples; ++i)
+    {
+        const auto x = input[i];
+        const auto y = b0 * x + s1;
+
+        s1 = b1 * x - a1 * y + s2;
+        s2 = b2 * x - a2 * y;
+
+        output[i] = y;
+    }
+}
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    BlockBiquad.h
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Drop-in replacement for juce::dsp::IIR::Filter<float> that computes a whole
+// vector of output samples per iteration. The biquad's transposed direct form II
+// state-space equations are unrolled blockLength samples ahead, so each output
+// lane is a fixed linear combination of the two states and the block's inputs.
+// That turns the serial recursion into independent SIMD multiply-adds across time,
+// which helps mono material where there are no channels to vectorise across.
+struct BlockBiquad
+{
+    using CoefficientsPtr = juce::dsp::IIR::Coefficients<float>::Ptr;
+
+    BlockBiquad();
+
+    void prepare(const juce::dsp::ProcessSpec& spec) noexcept;
+    void reset() noexcept;
+    void snapToZero() noexcept;
+
+    template <typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock = context.getOutputBlock();
+
+        jassert(inputBlock.getNumChannels() == 1);
+        jassert(outputBlock.getNumChannels() == 1);
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom(inputBlock);
+
+            return;
+        }
+
+        processSamples(inputBlock.getChannelPointer(0), outputBlock.getChannelPointer(0), outputBlock.getNumSamples());
+        snapToZero();
+    }
+
+    // Input and output may point to the same memory
+    void processSamples(const float* input, float* output, size_t numSamples) noexcept;
+
+    // Modified in place like IIR::Filter's; changes are picked up on the next process call
+    CoefficientsPtr coefficients;
+
+#if JUCE_USE_SIMD
+    static constexpr size_t blockLength = juce::dsp::SIMDRegister<float>::SIMDNumElements;
+#else
+    static constexpr size_t blockLength = 4;
+#endif
+
+private:
+    void updateLookAhead() noexcept;
+
+    // b0, b1, b2, a1, a2 the look-ahead matrices were built from
+    std::array<float, 5> current{};
+
+    // outputColumns[j][k]: weight of basis j (s1, s2, x[0] ... x[blockLength - 1]) in output k
+    alignas(32) float outputColumns[blockLength + 2][blockLength];
+
+    // stateRows[i][j]: weight of basis j in state i after the block
+    float stateRows[2][blockLength + 2];
+
+    float s1{ 0 }, s2{ 0 };
+};
@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+
+    CoefficientTables.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "CoefficientTables.h"
+
+namespace
+{
+    // Just below Nyquist, where the designs still make sense
+    constexpr float maximumNormalisedFrequency = 0.4999f;
+    constexpr float minimumNormalisedFrequency = 1.f / (float)(1 << CoefficientTables::numOctaves);
+
+    // ArrayCoefficients holds bells and shelves at 2 Hz or above too
+    constexpr float minimumBandFrequency = 2.f;
+
+    constexpr float minimumGainInDecibels = -96.f;
+    constexpr float maximumGainInDecibels = 96.f;
+    constexpr float gainPointsPerDecibel = 10.f;
+
+    struct AmplitudeTable
+    {
+        AmplitudeTable()
+        {
+            const auto numPoints = (int)((maximumGainInDecibels - minimumGainInDecibels) * gainPointsPerDecibel) + 2;
+
+            for (int i = 0; i < numPoints; ++i)
+                amplitudes.push_back((float)std::pow(10.0, (minimumGainInDecibels + i / gainPointsPerDecibel) / 40.0));
+        }
+
+        std::vector<float> amplitudes;
+    };
+
+    const AmplitudeTable& getAmplitudeTable()
+    {
+        static const AmplitudeTable table;
+        return table;
+    }
+}
+
+std::shared_ptr<const CoefficientTables> CoefficientTables::get(double sampleRate)
+{
+    static juce::CriticalSection lock;
+    static std::map<double, std::weak_ptr<const CoefficientTables>> cache;
+
+    const juce::ScopedLock scope(lock);
+
+    auto& entry = cache[sampleRate];
+
+    if (auto tables = entry.lock())
+        return tables;
+
+    auto tables = std::make_shared<const CoefficientTables>(sampleRate);
+    entry = tables;
+
+    return tables;
+}
+
+CoefficientTables::CoefficientTables(double newSampleRate)
+    : sampleRate(newSampleRate),
+      inverseSampleRate((float)(1.0 / newSampleRate))
+{
+    jassert(sampleRate > 0.0);
+
+    angles.reserve((size_t)(numOctaves * (pointsPerOctave + 1)));
+
+    for (int octave = 0; octave < numOctaves; ++octave)
+    {
+        const auto start = std::pow(2.0, -(octave + 1));
+
+        for (int point = 0; point <= pointsPerOctave; ++point)
+        {
+            const auto omega = juce::MathConstants<double>::twoPi * start * (1.0 + (double)point / pointsPerOctave);
+            angles.push_back({ (float)std::cos(omega), (float)std::sin(omega) });
+        }
+    }
+
+    // Built on first use, make sure that isn't on the audio thread
+    getAmplitudeTable();
+}
+
+CoefficientTables::Angle CoefficientTables::getAngle(float frequency) const noexcept
+{
+    const auto normalised = juce::jlimit(minimumNormalisedFrequency, maximumNormalisedFrequency, frequency * inverseSampleRate);
+
+    // normalised = mantissa * 2^exponent, mantissa in [0.5, 1), so the exponent picks the octave
+    int exponent = 0;
+    const auto mantissa = std::frexp(normalised, &exponent);
+    const auto octave = juce::jmin(-exponent, numOctaves - 1);
+
+    const auto position = (2.f * mantissa - 1.f) * (float)pointsPerOctave;
+    const auto index = juce::jmin((int)position, pointsPerOctave - 1);
+    const auto fraction = position - (float)index;
+
+    const auto* point = angles.data() + octave * (pointsPerOctave + 1) + index;
+
+    return { point[0].cosine + fraction * (point[1].cosine - point[0].cosine),
+             point[0].sine + fraction * (point[1].sine - point[0].sine) };
+}
+
+float CoefficientTables::getAmplitude(float gainInDecibels) noexcept
+{
+    const auto& amplitudes = getAmplitudeTable().amplitudes;
+
+    const auto position = (juce::jlimit(minimumGainInDecibels, maximumGainInDecibels, gainInDecibels) - minimumGainInDecibels) * gainPointsPerDecibel;
+    const auto index = juce::jmin((int)position, (int)amplitudes.size() - 2);
+    const auto fraction = position - (float)index;
+
+    return amplitudes[(size_t)index] + fraction * (amplitudes[(size_t)index + 1] - amplitudes[(size_t)index]);
+}
+
+std::array<float, 6> CoefficientTables::makePeak(float frequency, float q, float gainInDecibels) const noexcept
+{
+    const auto angle = getAngle(juce::jmax(frequency, minimumBandFrequency));
+    const auto amplitude = getAmplitude(gainInDecibels);
+    const auto inverseAmplitude = getAmplitude(-gainInDecibels);
+
+    const auto alpha = angle.sine * (0.5f / q);
+    const auto c2 = -2.f * angle.cosine;
+    const auto alphaTimesA = alpha * amplitude;
+    const auto alphaOverA = alpha * inverseAmplitude;
+
+    return { 1.f + alphaTimesA, c2, 1.f - alphaTimesA, 1.f + alphaOverA, c2, 1.f - alphaOverA };
+}
+
+std::array<float, 6> CoefficientTables::makeLowShelf(float frequency, float q, float gainInDecibels) const noexcept
+{
+    const auto angle = getAngle(juce::jmax(frequency, minimumBandFrequency));
+    const auto amplitude = getAmplitude(gainInDecibels);
+
+    const auto aMinus1 = amplitude - 1.f;
+    const auto aPlus1 = amplitude + 1.f;
+    const auto beta = angle.sine * getAmplitude(0.5f * gainInDecibels) / q;
+    const auto aMinus1TimesCos = aMinus1 * angle.cosine;
+
+    return { amplitude * (aPlus1 - aMinus1TimesCos + beta),
+             amplitude * 2.f * (aMinus1 - aPlus1 * angle.cosine),
+             amplitude * (aPlus1 - aMinus1TimesCos - beta),
+             aPlus1 + aMinus1TimesCos + beta,
+             -2.f * (aMinus1 + aPlus1 * angle.cosine),
+             aPlus1 + aMinus1TimesCos - beta };
+}
+
+std::array<float, 6> CoefficientTables::makeHighShelf(float frequency, float q, float gainInDecibels) const noexcept
+{
+    const auto angle = getAngle(juce::jmax(frequency, minimumBandFrequency));
+    const auto amplitude = getAmplitude(gainInDecibels);
+
+    const auto aMinus1 = amplitude - 1.f;
+    const auto aPlus1 = amplitude + 1.f;
+    const auto beta = angle.sine * getAmplitude(0.5f * gainInDecibels) / q;
+    const auto aMinus1TimesCos = aMinus1 * angle.cosine;
+
+    return { amplitude * (aPlus1 + aMinus1TimesCos + beta),
+             amplitude * -2.f * (aMinus1 + aPlus1 * angle.cosine),
+             amplitude * (aPlus1 + aMinus1TimesCos - beta),
+             aPlus1 - aMinus1TimesCos + beta,
+             2.f * (aMinus1 - aPlus1 * angle.cosine),
+             aPlus1 - aMinus1TimesCos - beta };
+}
+
+std::array<float, 6> CoefficientTables::makeHighPass(float frequency, float q) const noexcept
+{
+    // tan(omega / 2) without the tangent
+    const auto angle = getAngle(frequency);
+    const auto n = angle.sine / (1.f + angle.cosine);
+    const auto nSquared = n * n;
+    const auto invQ = 1.f / q;
+    const auto c1 = 1.f / (1.f + invQ * n + nSquared);
+
+    return { c1, c1 * -2.f, c1, 1.f, c1 * 2.f * (nSquared - 1.f), c1 * (1.f - invQ * n + nSquared) };
+}
+
+std::array<float, 6> CoefficientTables::makeLowPass(float frequency, float q) const noexcept
+{
+    // 1 / tan(omega / 2)
+    const auto angle = getAngle(frequency);
+    const auto n = (1.f + angle.cosine) / angle.sine;
+    const auto nSquared = n * n;
+    const auto invQ = 1.f / q;
+    const auto c1 = 1.f / (1.f + invQ * n + nSquared);
+
+    return { c1, c1 * 2.f, c1, 1.f, c1 * 2.f * (1.f - nSquared), c1 * (1.f - invQ * n + nSquared) };
+}
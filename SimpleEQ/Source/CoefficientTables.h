@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    CoefficientTables.h
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// The trigonometry behind every biquad design, tabulated for one sample rate.
+// Cosine and sine of the normalised angle are stored per octave at evenly
+// spaced points, so a lookup is a frexp, two loads and a linear interpolation;
+// dB to amplitude comes from a rate independent table the same way. Designs
+// match juce::dsp::IIR::ArrayCoefficients, b0, b1, b2, a0, a1, a2 unnormalised.
+class CoefficientTables
+{
+public:
+    // One set per sample rate, shared by every processor running at that rate.
+    // Builds the tables if nobody holds them yet. Allocates, message thread.
+    static std::shared_ptr<const CoefficientTables> get(double sampleRate);
+
+    explicit CoefficientTables(double sampleRate);
+
+    double getSampleRate() const { return sampleRate; }
+
+    std::array<float, 6> makePeak(float frequency, float q, float gainInDecibels) const noexcept;
+    std::array<float, 6> makeLowShelf(float frequency, float q, float gainInDecibels) const noexcept;
+    std::array<float, 6> makeHighShelf(float frequency, float q, float gainInDecibels) const noexcept;
+
+    // One second order section of a Butterworth cascade
+    std::array<float, 6> makeHighPass(float frequency, float q) const noexcept;
+    std::array<float, 6> makeLowPass(float frequency, float q) const noexcept;
+
+    static constexpr int pointsPerOctave = 512;
+    static constexpr int numOctaves = 20;
+
+private:
+    struct Angle
+    {
+        float cosine, sine;
+    };
+
+    // cos and sin of 2 pi frequency / sampleRate
+    Angle getAngle(float frequency) const noexcept;
+
+    // 10^(dB / 40), the amplitude the RBJ designs work with
+    static float getAmplitude(float gainInDecibels) noexcept;
+
+    double sampleRate;
+    float inverseSampleRate;
+
+    // Octave o covers normalised frequencies 2^-(o + 1) to 2^-o, both ends included
+    std::vector<Angle> angles;
+};
@@ -0,0 +1,405 @@
+/*
+  ==============================================================================
+
+    Crossover.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "Crossover.h"
+
+namespace
+{
+    struct CrossoverDesign
+    {
+        CutCoefficientArrays lowPass{}, highPass{}, allPass{};
+        Slope cutSlope{ Slope::Slope_24 }, allPassSlope{ Slope::Slope_12 };
+        float poleRadius{ 0.f };
+    };
+
+    // The Linkwitz-Riley response is the Butterworth one squared, so each cut
+    // cascade holds the Butterworth sections twice. Low and high pass share
+    // their poles, and the allpass their sum amounts to is those poles with the
+    // numerator reversed, so all three come out of one bilinear transform.
+    CrossoverDesign designCrossover(float frequency, double sampleRate, Slope slope)
+    {
+        // Section Qs of 2nd and 4th order Butterworth filters
+        const double secondOrderQs[] = { 0.70710678 };
+        const double fourthOrderQs[] = { 0.54119610, 1.30656296 };
+
+        const auto fourthOrder = slope == Slope::Slope_48;
+        const auto numSections = fourthOrder ? 2 : 1;
+
+        const auto limited = juce::jlimit(10.0, 0.49 * sampleRate, (double)frequency);
+        const auto k = std::tan(juce::MathConstants<double>::pi * limited / sampleRate);
+
+        CrossoverDesign design;
+
+        for (int i = 0; i < numSections; ++i)
+        {
+            const auto q = fourthOrder ? fourthOrderQs[i] : secondOrderQs[i];
+            const auto norm = 1.0 / (1.0 + k / q + k * k);
+            const auto a1 = (float)(2.0 * (k * k - 1.0) * norm);
+            const auto a2 = (float)((1.0 - k / q + k * k) * norm);
+            const auto lowGain = (float)(k * k * norm);
+            const auto highGain = (float)norm;
+
+            const CoefficientArray lowPass{ lowGain, 2.f * lowGain, lowGain, 1.f, a1, a2 };
+            const CoefficientArray highPass{ highGain, -2.f * highGain, highGain, 1.f, a1, a2 };
+
+            design.lowPass[(size_t)i] = design.lowPass[(size_t)(i + numSections)] = lowPass;
+            design.highPass[(size_t)i] = design.highPass[(size_t)(i + numSections)] = highPass;
+            design.allPass[(size_t)i] = { a2, a1, 1.f, 1.f, a1, a2 };
+
+            // Butterworth sections all have Q above 0.5, so their poles are a conjugate pair
+            design.poleRadius = juce::jmax(design.poleRadius, std::sqrt(juce::jmax(0.f, a2)));
+        }
+
+        design.cutSlope = fourthOrder ? Slope::Slope_48 : Slope::Slope_24;
+        design.allPassSlope = fourthOrder ? Slope::Slope_24 : Slope::Slope_12;
+
+        return design;
+    }
+
+    void processInPlace(CutFilter& filter, float* data, size_t numSamples)
+    {
+        juce::dsp::AudioBlock<float> block(&data, 1, numSamples);
+        juce::dsp::ProcessContextReplacing<float> context(block);
+        filter.process(context);
+    }
+}
+
+//==============================================================================
+void CrossoverParameters::attach(juce::AudioProcessorValueTreeState& apvts)
+{
+    numBands = apvts.getRawParameterValue("Crossover Bands");
+    slope = apvts.getRawParameterValue("Crossover Slope");
+
+    for (int i = 0; i < maxCrossoverBands - 1; ++i)
+        frequencies[i] = apvts.getRawParameterValue("Crossover " + juce::String(i + 1) + " Freq");
+
+    for (int i = 0; i < maxCrossoverBands; ++i)
+    {
+        gains[i] = apvts.getRawParameterValue("Band " + juce::String(i + 1) + " Gain");
+        solo[i] = apvts.getRawParameterValue("Band " + juce::String(i + 1) + " Solo");
+    }
+}
+
+CrossoverSettings CrossoverParameters::load() const
+{
+    CrossoverSettings settings;
+
+    // "Off" is the first choice, so the index is one below the band count
+    settings.numBands = (int)numBands->load() + 1;
+    settings.slope = slope->load() > 0.5f ? Slope::Slope_48 : Slope::Slope_24;
+
+    for (int i = 0; i < maxCrossoverBands - 1; ++i)
+        settings.frequencies[i] = frequencies[i]->load();
+
+    for (int i = 0; i < maxCrossoverBands; ++i)
+    {
+        settings.gainsInDecibels[i] = gains[i]->load();
+        settings.solo[i] = solo[i]->load() > 0.5f;
+    }
+
+    return settings;
+}
+
+void addCrossoverParameters(juce::AudioProcessorValueTreeState::ParameterLayout& layout)
+{
+    layout.add(std::make_unique < juce::AudioParameterChoice >(
+        "Crossover Bands",
+        "Crossover Bands",
+        juce::StringArray{ "Off", "2 Bands", "3 Bands", "4 Bands" },
+        0));
+
+    layout.add(std::make_unique < juce::AudioParameterChoice >(
+        "Crossover Slope",
+        "Crossover Slope",
+        juce::StringArray{ "24 db/Oct", "48 db/Oct" },
+        0));
+
+    const float defaultFrequencies[] = { 200.f, 2000.f, 8000.f };
+
+    for (int i = 0; i < maxCrossoverBands - 1; ++i)
+    {
+        const auto name = "Crossover " + juce::String(i + 1) + " Freq";
+
+        layout.add(std::make_unique < juce::AudioParameterFloat >(
+            name,
+            name,
+            juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
+            defaultFrequencies[i]));
+    }
+
+    for (int i = 0; i < maxCrossoverBands; ++i)
+    {
+        const auto prefix = "Band " + juce::String(i + 1);
+
+        layout.add(std::make_unique < juce::AudioParameterFloat >(
+            prefix + " Gain",
+            prefix + " Gain",
+            juce::NormalisableRange<float>(-24.f, 24.f, 0.2f, 1.f),
+            0.0f));
+
+        layout.add(std::make_unique < juce::AudioParameterBool >(
+            prefix + " Solo",
+            prefix + " Solo",
+            false));
+    }
+}
+
+//==============================================================================
+Crossover::Crossover()
+{
+    for (int band = 0; band < maxCrossoverBands; ++band)
+    {
+        gains[band].setCurrentAndTargetValue(1.f);
+        audible[band].setCurrentAndTargetValue(1.f);
+    }
+}
+
+void Crossover::prepare(double newSampleRate, int maximumBlockSize)
+{
+    sampleRate = newSampleRate;
+
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = sampleRate;
+    spec.maximumBlockSize = (juce::uint32)maximumBlockSize;
+    spec.numChannels = 1;
+
+    for (auto& filters : channels)
+    {
+        for (int crossover = 0; crossover < maxCrossoverBands - 1; ++crossover)
+        {
+            filters.lowPasses[crossover].prepare(spec);
+            filters.highPasses[crossover].prepare(spec);
+
+            for (auto& allPasses : filters.allPasses)
+                allPasses[crossover].prepare(spec);
+        }
+    }
+
+    bandBuffers.setSize(maxCrossoverBands * numChannels, juce::jmax(1, maximumBlockSize));
+
+    for (int band = 0; band < maxCrossoverBands; ++band)
+    {
+        gains[band].reset(sampleRate, gainRampLengthInSeconds);
+        audible[band].reset(sampleRate, gainRampLengthInSeconds);
+    }
+
+    // The designs only hold for the rate they were made at
+    designed = false;
+    setSettings(current);
+    reset();
+}
+
+void Crossover::reset()
+{
+    for (auto& filters : channels)
+    {
+        for (int crossover = 0; crossover < maxCrossoverBands - 1; ++crossover)
+        {
+            filters.lowPasses[crossover].reset();
+            filters.highPasses[crossover].reset();
+
+            for (auto& allPasses : filters.allPasses)
+                allPasses[crossover].reset();
+        }
+    }
+
+    for (int band = 0; band < maxCrossoverBands; ++band)
+    {
+        gains[band].setCurrentAndTargetValue(gains[band].getTargetValue());
+        audible[band].setCurrentAndTargetValue(audible[band].getTargetValue());
+    }
+}
+
+void Crossover::design(int crossover, float frequency, Slope slope)
+{
+    const auto design = designCrossover(frequency, sampleRate, slope);
+
+    for (auto& filters : channels)
+    {
+        updateCutFilter(filters.lowPasses[crossover], design.lowPass, design.cutSlope);
+        updateCutFilter(filters.highPasses[crossover], design.highPass, design.cutSlope);
+
+        // Only the bands below a crossover need its phase shift
+        for (int band = 0; band < crossover; ++band)
+            updateCutFilter(filters.allPasses[band][crossover], design.allPass, design.allPassSlope);
+    }
+
+    poleRadii[crossover] = design.poleRadius;
+}
+
+bool Crossover::setSettings(const CrossoverSettings& settings)
+{
+    auto target = settings;
+    target.numBands = juce::jlimit(1, maxCrossoverBands, target.numBands);
+
+    // Crossovers can't pass each other, each sits at or above the one below
+    for (int i = 1; i < maxCrossoverBands - 1; ++i)
+        target.frequencies[i] = juce::jmax(target.frequencies[i], target.frequencies[i - 1]);
+
+    auto changed = false;
+
+    // Unused crossovers are kept designed, so changing the band count never redesigns
+    for (int crossover = 0; crossover < maxCrossoverBands - 1; ++crossover)
+    {
+        if (! designed || target.frequencies[crossover] != current.frequencies[crossover] || target.slope != current.slope)
+        {
+            design(crossover, target.frequencies[crossover], target.slope);
+            changed = true;
+        }
+    }
+
+    const auto anySolo = std::any_of(target.solo, target.solo + target.numBands, [](bool solo) { return solo; });
+
+    for (int band = 0; band < maxCrossoverBands; ++band)
+    {
+        gains[band].setTargetValue(juce::Decibels::decibelsToGain(target.gainsInDecibels[band]));
+        audible[band].setTargetValue(! anySolo || target.solo[band] ? 1.f : 0.f);
+    }
+
+    const auto numBandsChanged = target.numBands != current.numBands;
+
+    current = target;
+    designed = true;
+
+    // Each band now carries something else, start it clean
+    if (numBandsChanged)
+        reset();
+
+    return changed || numBandsChanged;
+}
+
+void Crossover::process(juce::dsp::AudioBlock<float>& block,
+                        const std::array<juce::dsp::AudioBlock<float>, maxCrossoverBands>& auxOutputs)
+{
+    // Hosts can send more than they announced in prepare, split rather than overrun
+    const auto chunkLength = (size_t)bandBuffers.getNumSamples();
+
+    if (block.getNumSamples() <= chunkLength)
+    {
+        processChunk(block, auxOutputs);
+        return;
+    }
+
+    for (size_t position = 0; position < block.getNumSamples(); position += chunkLength)
+    {
+        const auto length = juce::jmin(chunkLength, block.getNumSamples() - position);
+        auto chunk = block.getSubBlock(position, length);
+        std::array<juce::dsp::AudioBlock<float>, maxCrossoverBands> auxChunks;
+
+        for (size_t band = 0; band < auxOutputs.size(); ++band)
+            if (auxOutputs[band].getNumChannels() > 0)
+                auxChunks[band] = auxOutputs[band].getSubBlock(position, length);
+
+        processChunk(chunk, auxChunks);
+    }
+}
+
+void Crossover::processChunk(juce::dsp::AudioBlock<float>& block,
+                             const std::array<juce::dsp::AudioBlock<float>, maxCrossoverBands>& auxOutputs)
+{
+    const auto numBands = current.numBands;
+    const auto numSamples = block.getNumSamples();
+    const auto numBlockChannels = juce::jmin((int)block.getNumChannels(), numChannels);
+
+    jassert(numSamples <= (size_t)bandBuffers.getNumSamples());
+
+    const auto getBand = [this](int band, int channel)
+    {
+        return bandBuffers.getWritePointer(band * numChannels + channel);
+    };
+
+    for (int channel = 0; channel < numBlockChannels; ++channel)
+    {
+        auto& filters = channels[channel];
+
+        // Each split takes what is left above the previous one
+        juce::FloatVectorOperations::copy(getBand(0, channel), block.getChannelPointer((size_t)channel), (int)numSamples);
+
+        for (int crossover = 0; crossover < numBands - 1; ++crossover)
+        {
+            juce::FloatVectorOperations::copy(getBand(crossover + 1, channel), getBand(crossover, channel), (int)numSamples);
+
+            processInPlace(filters.lowPasses[crossover], getBand(crossover, channel), numSamples);
+            processInPlace(filters.highPasses[crossover], getBand(crossover + 1, channel), numSamples);
+
+            for (int band = 0; band < crossover; ++band)
+                processInPlace(filters.allPasses[band][crossover], getBand(band, channel), numSamples);
+        }
+    }
+
+    block.clear();
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        auto& gain = gains[band];
+
+        if (gain.isSmoothing())
+        {
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                const auto value = gain.getNextValue();
+
+                for (int channel = 0; channel < numBlockChannels; ++channel)
+                    getBand(band, channel)[i] *= value;
+            }
+        }
+        else if (gain.getTargetValue() != 1.f)
+        {
+            for (int channel = 0; channel < numBlockChannels; ++channel)
+                juce::FloatVectorOperations::multiply(getBand(band, channel), gain.getTargetValue(), (int)numSamples);
+        }
+
+        // The aux outputs are for parallel processing, so solo doesn't apply to them
+        const auto& aux = auxOutputs[(size_t)band];
+
+        for (int channel = 0; channel < juce::jmin((int)aux.getNumChannels(), numBlockChannels); ++channel)
+            juce::FloatVectorOperations::copy(aux.getChannelPointer((size_t)channel), getBand(band, channel), (int)numSamples);
+
+        auto& level = audible[band];
+
+        if (level.isSmoothing())
+        {
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                const auto value = level.getNextValue();
+
+                for (int channel = 0; channel < numBlockChannels; ++channel)
+                    block.getChannelPointer((size_t)channel)[i] += value * getBand(band, channel)[i];
+            }
+        }
+        else if (level.getTargetValue() > 0.f)
+        {
+            for (int channel = 0; channel < numBlockChannels; ++channel)
+                juce::FloatVectorOperations::add(block.getChannelPointer((size_t)channel), getBand(band, channel), (int)numSamples);
+        }
+    }
+}
+
+double Crossover::getTailLengthInSamples() const
+{
+    if (current.numBands < 2)
+        return 0.0;
+
+    auto radius = 0.f;
+
+    for (int crossover = 0; crossover < current.numBands - 1; ++crossover)
+        radius = juce::jmax(radius, poleRadii[crossover]);
+
+    if (radius <= 0.f || radius >= 1.f)
+        return 0.0;
+
+    // The lowest band passes one cut cascade and every later crossover's allpass,
+    // summing the sections' decays is conservative
+    const auto cutSections = current.slope == Slope::Slope_48 ? 4 : 2;
+    const auto allPassSections = current.slope == Slope::Slope_48 ? 2 : 1;
+    const auto numSections = cutSections + (current.numBands - 2) * allPassSections;
+
+    return numSections * std::log(1.0e-6) / std::log((double)radius);
+}
@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    Crossover.h
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+constexpr int maxCrossoverBands = 4;
+
+struct CrossoverSettings
+{
+    // 1 leaves the signal unsplit
+    int numBands{ 1 };
+    float frequencies[maxCrossoverBands - 1]{ 200.f, 2000.f, 8000.f };
+    // Slope_24 or Slope_48, the Linkwitz-Riley orders with a flat sum
+    Slope slope{ Slope::Slope_24 };
+    float gainsInDecibels[maxCrossoverBands]{};
+    bool solo[maxCrossoverBands]{};
+};
+
+// The "Crossover" parameters, looked up once like ChainParameters
+struct CrossoverParameters
+{
+    void attach(juce::AudioProcessorValueTreeState& apvts);
+    CrossoverSettings load() const;
+
+private:
+    std::atomic<float>* numBands{ nullptr };
+    std::atomic<float>* slope{ nullptr };
+    std::atomic<float>* frequencies[maxCrossoverBands - 1]{};
+    std::atomic<float>* gains[maxCrossoverBands]{};
+    std::atomic<float>* solo[maxCrossoverBands]{};
+};
+
+void addCrossoverParameters(juce::AudioProcessorValueTreeState::ParameterLayout& layout);
+
+// Splits a stereo block into 2-4 bands with Linkwitz-Riley crossovers, each a
+// Butterworth CutFilter cascade run twice. The bands below each later split
+// get the matching allpass, so the sum is flat in magnitude and every band has
+// the same phase. The low pass, high pass and allpass of one crossover share a
+// denominator, designed once. All stages are BlockBiquads, vectorised across time.
+class Crossover
+{
+public:
+    Crossover();
+
+    void prepare(double sampleRate, int maximumBlockSize);
+    void reset();
+
+    // Redesigns the crossovers that moved and sets the band gains to ramp to.
+    // Returns true if anything was redesigned. Doesn't allocate.
+    bool setSettings(const CrossoverSettings& settings);
+
+    int getNumBands() const { return current.numBands; }
+
+    // Replaces the block with the sum of the audible bands, after their gains.
+    // Band outputs go to the matching non-empty auxOutputs too, regardless of solo.
+    void process(juce::dsp::AudioBlock<float>& block,
+                 const std::array<juce::dsp::AudioBlock<float>, maxCrossoverBands>& auxOutputs);
+
+    // Until the slowest crossover section has decayed by 120 dB
+    double getTailLengthInSamples() const;
+
+private:
+    static constexpr int numChannels = 2;
+    static constexpr double gainRampLengthInSeconds = 0.02;
+
+    // allPasses[band][crossover] puts crossover's phase shift on a band below it
+    struct ChannelFilters
+    {
+        CutFilter lowPasses[maxCrossoverBands - 1];
+        CutFilter highPasses[maxCrossoverBands - 1];
+        CutFilter allPasses[maxCrossoverBands - 1][maxCrossoverBands - 1];
+    };
+
+    void design(int crossover, float frequency, Slope slope);
+
+    // At most bandBuffers' length at a time
+    void processChunk(juce::dsp::AudioBlock<float>& block,
+                      const std::array<juce::dsp::AudioBlock<float>, maxCrossoverBands>& auxOutputs);
+
+    double sampleRate{ 44100.0 };
+    CrossoverSettings current;
+    bool designed{ false };
+
+    ChannelFilters channels[numChannels];
+    juce::AudioBuffer<float> bandBuffers;
+
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> gains[maxCrossoverBands];
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> audible[maxCrossoverBands];
+
+    // Pole radius of the slowest section of each crossover
+    float poleRadii[maxCrossoverBands - 1]{};
+};
@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    DynamicsDetector.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "DynamicsDetector.h"
+
+bool operator!=(const BandDynamics& a, const BandDynamics& b)
+{
+    return a.enabled != b.enabled
+        || a.thresholdInDecibels != b.thresholdInDecibels
+        || a.ratio != b.ratio
+        || a.attackInMilliseconds != b.attackInMilliseconds
+        || a.releaseInMilliseconds != b.releaseInMilliseconds;
+}
+
+float getGainReductionInDecibels(const BandDynamics& dynamics, float envelope)
+{
+    if (! dynamics.enabled || dynamics.ratio <= 1.f)
+        return 0.f;
+
+    const auto overshoot = juce::Decibels::gainToDecibels(envelope, -100.f) - dynamics.thresholdInDecibels;
+
+    if (overshoot <= 0.f)
+        return 0.f;
+
+    // No deeper than the band gain range
+    return juce::jmin(24.f, overshoot * (1.f - 1.f / dynamics.ratio));
+}
+
+void DynamicsDetector::prepare(double newSampleRate) noexcept
+{
+    sampleRate = newSampleRate;
+    reset();
+}
+
+void DynamicsDetector::reset() noexcept
+{
+    std::fill(std::begin(s1), std::end(s1), 0.f);
+    std::fill(std::begin(s2), std::end(s2), 0.f);
+    std::fill(std::begin(envelope), std::end(envelope), 0.f);
+}
+
+void DynamicsDetector::setLane(size_t lane, const std::array<float, 6>& coefficients, const BandDynamics& dynamics) noexcept
+{
+    jassert(lane < numLanes);
+
+    const auto a0 = coefficients[3];
+
+    b0[lane] = coefficients[0] / a0;
+    b1[lane] = coefficients[1] / a0;
+    b2[lane] = coefficients[2] / a0;
+    a1[lane] = coefficients[4] / a0;
+    a2[lane] = coefficients[5] / a0;
+
+    const auto getSmoothing = [this](float milliseconds)
+    {
+        return (float)std::exp(-1.0 / (juce::jmax(0.01, (double)milliseconds) * 0.001 * sampleRate));
+    };
+
+    attack[lane] = getSmoothing(dynamics.attackInMilliseconds);
+    release[lane] = getSmoothing(dynamics.releaseInMilliseconds);
+}
+
+void DynamicsDetector::clearLane(size_t lane) noexcept
+{
+    jassert(lane < numLanes);
+
+    b0[lane] = b1[lane] = b2[lane] = a1[lane] = a2[lane] = 0.f;
+    s1[lane] = s2[lane] = envelope[lane] = 0.f;
+}
+
+void DynamicsDetector::process(const float* input, size_t numSamples) noexcept
+{
+   #if JUCE_USE_SIMD
+    using Vec = juce::dsp::SIMDRegister<float>;
+    constexpr auto width = Vec::SIMDNumElements;
+    static_assert(numLanes % width == 0, "Lanes must fill whole registers");
+
+    for (size_t lane = 0; lane < numLanes; lane += width)
+    {
+        const auto vb0 = Vec::fromRawArray(b0 + lane), vb1 = Vec::fromRawArray(b1 + lane), vb2 = Vec::fromRawArray(b2 + lane);
+        const auto va1 = Vec::fromRawArray(a1 + lane), va2 = Vec::fromRawArray(a2 + lane);
+        const auto vattack = Vec::fromRawArray(attack + lane), vrelease = Vec::fromRawArray(release + lane);
+        const auto attackOffset = vattack - vrelease;
+
+        auto vs1 = Vec::fromRawArray(s1 + lane), vs2 = Vec::fromRawArray(s2 + lane);
+        auto venvelope = Vec::fromRawArray(envelope + lane);
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            const auto x = input[i];
+            const auto y = vb0 * x + vs1;
+
+            vs1 = vb1 * x - va1 * y + vs2;
+            vs2 = vb2 * x - va2 * y;
+
+            // Attack while the rectified signal is above the envelope, release otherwise
+            const auto rectified = Vec::max(y, Vec::expand(0.f) - y);
+            const auto coefficient = vrelease + (attackOffset & Vec::greaterThan(rectified, venvelope));
+
+            venvelope = rectified + coefficient * (venvelope - rectified);
+        }
+
+        vs1.copyToRawArray(s1 + lane);
+        vs2.copyToRawArray(s2 + lane);
+        venvelope.copyToRawArray(envelope + lane);
+    }
+   #else
+    for (size_t lane = 0; lane < numLanes; ++lane)
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            const auto x = input[i];
+            const auto y = b0[lane] * x + s1[lane];
+
+            s1[lane] = b1[lane] * x - a1[lane] * y + s2[lane];
+            s2[lane] = b2[lane] * x - a2[lane] * y;
+
+            const auto rectified = std::abs(y);
+            const auto coefficient = rectified > envelope[lane] ? attack[lane] : release[lane];
+
+            envelope[lane] = rectified + coefficient * (envelope[lane] - rectified);
+        }
+    }
+   #endif
+
+    for (size_t lane = 0; lane < numLanes; ++lane)
+    {
+        juce::dsp::util::snapToZero(s1[lane]);
+        juce::dsp::util::snapToZero(s2[lane]);
+    }
+}
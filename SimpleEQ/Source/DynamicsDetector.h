@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+
+    DynamicsDetector.h
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Envelope settings of one dynamic band. With a ratio above 1 the band's gain is
+// pulled down by the amount its detector exceeds the threshold, like a compressor.
+struct BandDynamics
+{
+    bool enabled{ false };
+    float thresholdInDecibels{ 0.f };
+    float ratio{ 1.f };
+    float attackInMilliseconds{ 10.f };
+    float releaseInMilliseconds{ 100.f };
+};
+
+bool operator!=(const BandDynamics& a, const BandDynamics& b);
+
+// Decibels to take off the band's gain for the given detector envelope
+float getGainReductionInDecibels(const BandDynamics& dynamics, float envelope);
+
+// A bank of band-limited detectors with peak envelope followers, one per lane.
+// The lanes are stored structure-of-arrays so every sample updates all of them
+// with a few SIMD multiply-adds, instead of running one filter per band.
+struct DynamicsDetector
+{
+    static constexpr size_t numLanes = 8;
+
+    void prepare(double newSampleRate) noexcept;
+    void reset() noexcept;
+
+    // b0, b1, b2, a0, a1, a2 as produced by juce::dsp::IIR::ArrayCoefficients
+    void setLane(size_t lane, const std::array<float, 6>& coefficients, const BandDynamics& dynamics) noexcept;
+    void clearLane(size_t lane) noexcept;
+
+    void process(const float* input, size_t numSamples) noexcept;
+
+    float getEnvelope(size_t lane) const noexcept { return envelope[lane]; }
+
+private:
+    double sampleRate{ 44100.0 };
+
+    alignas(32) float b0[numLanes]{}, b1[numLanes]{}, b2[numLanes]{}, a1[numLanes]{}, a2[numLanes]{};
+    alignas(32) float attack[numLanes]{}, release[numLanes]{};
+    alignas(32) float s1[numLanes]{}, s2[numLanes]{}, envelope[numLanes]{};
+};
@@ -0,0 +1,242 @@
+/*
+  ==============================================================================
+
+    FrequencyResponse.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "FrequencyResponse.h"
+
+#include <thread>
+
+namespace
+{
+    // Grid points evaluated together, small enough for the accumulators to live on the stack
+    constexpr size_t chunkSize = 64;
+
+    // Presets a thread takes at a time
+    constexpr size_t presetsPerTask = 16;
+
+    struct Accumulators
+    {
+        double real[chunkSize], imaginary[chunkSize], delay[chunkSize];
+    };
+
+    // Multiplies one section, a0 normalised to 1, into the running response.
+    // Straight-line arithmetic over arrays, which the compiler vectorises.
+    void accumulateSection(const CoefficientArray& section, const double* cos1, const double* sin1,
+                           const double* cos2, const double* sin2, size_t numPoints, Accumulators& acc) noexcept
+    {
+        const double b0 = section[0], b1 = section[1], b2 = section[2];
+        const double a1 = section[4], a2 = section[5];
+
+        for (size_t i = 0; i < numPoints; ++i)
+        {
+            // B and A at z = e^jw
+            const auto br = b0 + b1 * cos1[i] + b2 * cos2[i];
+            const auto bi = -(b1 * sin1[i] + b2 * sin2[i]);
+            const auto ar = 1.0 + a1 * cos1[i] + a2 * cos2[i];
+            const auto ai = -(a1 * sin1[i] + a2 * sin2[i]);
+
+            const auto bNorm = br * br + bi * bi;
+            const auto aNorm = ar * ar + ai * ai;
+
+            // Group delay of a polynomial P is Re(P' / P), P' = sum of k * p_k * z^-k.
+            // A zero right on the unit circle has none.
+            const auto dbr = b1 * cos1[i] + 2.0 * b2 * cos2[i];
+            const auto dbi = -(b1 * sin1[i] + 2.0 * b2 * sin2[i]);
+            const auto dar = a1 * cos1[i] + 2.0 * a2 * cos2[i];
+            const auto dai = -(a1 * sin1[i] + 2.0 * a2 * sin2[i]);
+
+            acc.delay[i] += (dbr * br + dbi * bi) / std::max(bNorm, 1.0e-300)
+                          - (dar * ar + dai * ai) / std::max(aNorm, 1.0e-300);
+
+            // H *= B / A
+            const auto hr = (br * ar + bi * ai) / aNorm;
+            const auto hi = (bi * ar - br * ai) / aNorm;
+            const auto real = acc.real[i] * hr - acc.imaginary[i] * hi;
+
+            acc.imaginary[i] = acc.real[i] * hi + acc.imaginary[i] * hr;
+            acc.real[i] = real;
+        }
+    }
+
+    bool isStable(const CoefficientArray& section) noexcept
+    {
+        const auto a1 = section[4], a2 = section[5];
+
+        for (auto coefficient : section)
+            if (! std::isfinite(coefficient))
+                return false;
+
+        // Both poles inside the unit circle
+        return std::abs(a2) < 1.f && std::abs(a1) < 1.f + a2;
+    }
+
+    // Every active section of a chain, in processing order
+    template <typename Callback>
+    void forEachSection(const ChainCoefficients& coefficients, Callback&& callback)
+    {
+        for (int i = 0; i < coefficients.numHighPassSections; ++i)
+            callback(coefficients.highPass[(size_t)i]);
+
+        callback(coefficients.lowShelf);
+
+        for (const auto& peak : coefficients.peaks)
+            callback(peak);
+
+        callback(coefficients.highShelf);
+
+        for (int i = 0; i < coefficients.numLowPassSections; ++i)
+            callback(coefficients.lowPass[(size_t)i]);
+    }
+}
+
+FrequencyGrid::FrequencyGrid(std::vector<double> frequenciesToUse, double rate)
+    : frequencies(std::move(frequenciesToUse)), sampleRate(rate),
+      cos1(frequencies.size()), sin1(frequencies.size()), cos2(frequencies.size()), sin2(frequencies.size())
+{
+    for (size_t i = 0; i < frequencies.size(); ++i)
+    {
+        const auto w = juce::MathConstants<double>::twoPi * frequencies[i] / sampleRate;
+
+        cos1[i] = std::cos(w);
+        sin1[i] = std::sin(w);
+        cos2[i] = std::cos(2.0 * w);
+        sin2[i] = std::sin(2.0 * w);
+    }
+}
+
+FrequencyGrid FrequencyGrid::logarithmic(int numPoints, double minimumFrequency, double maximumFrequency, double sampleRate)
+{
+    std::vector<double> frequencies((size_t)juce::jmax(1, numPoints));
+
+    for (size_t i = 0; i < frequencies.size(); ++i)
+        frequencies[i] = juce::mapToLog10(frequencies.size() > 1 ? (double)i / (double)(frequencies.size() - 1) : 0.0,
+                                          minimumFrequency, maximumFrequency);
+
+    return { std::move(frequencies), sampleRate };
+}
+
+void computeFrequencyResponse(const ChainCoefficients& coefficients, const FrequencyGrid& grid, FrequencyResponse& result)
+{
+    const auto numPoints = grid.size();
+
+    result.magnitudeInDecibels.resize(numPoints);
+    result.phaseInRadians.resize(numPoints);
+    result.groupDelayInSamples.resize(numPoints);
+
+    Accumulators acc;
+
+    for (size_t start = 0; start < numPoints; start += chunkSize)
+    {
+        const auto length = std::min(chunkSize, numPoints - start);
+
+        std::fill(acc.real, acc.real + length, 1.0);
+        std::fill(acc.imaginary, acc.imaginary + length, 0.0);
+        std::fill(acc.delay, acc.delay + length, 0.0);
+
+        forEachSection(coefficients, [&](const CoefficientArray& section)
+        {
+            accumulateSection(section, grid.cos1.data() + start, grid.sin1.data() + start,
+                              grid.cos2.data() + start, grid.sin2.data() + start, length, acc);
+        });
+
+        for (size_t i = 0; i < length; ++i)
+        {
+            const auto power = acc.real[i] * acc.real[i] + acc.imaginary[i] * acc.imaginary[i];
+
+            result.magnitudeInDecibels[start + i] = (float)(10.0 * std::log10(std::max(power, 1.0e-30)));
+            result.phaseInRadians[start + i] = (float)std::atan2(acc.imaginary[i], acc.real[i]);
+            result.groupDelayInSamples[start + i] = (float)acc.delay[i];
+        }
+    }
+}
+
+FrequencyResponse computeFrequencyResponse(const ChainSettings& chainSettings, const FrequencyGrid& grid)
+{
+    FrequencyResponse response;
+    computeFrequencyResponse(makeChainCoefficients(chainSettings, grid.getSampleRate()), grid, response);
+    return response;
+}
+
+ResponseCheck checkFrequencyResponse(const FrequencyResponse& response, const FrequencyGrid& grid,
+                                     const ChainCoefficients& coefficients, const ResponseLimits& limits)
+{
+    ResponseCheck check;
+    check.peakGainInDecibels = -std::numeric_limits<float>::infinity();
+
+    for (size_t i = 0; i < response.magnitudeInDecibels.size(); ++i)
+    {
+        if (response.magnitudeInDecibels[i] > check.peakGainInDecibels)
+        {
+            check.peakGainInDecibels = response.magnitudeInDecibels[i];
+            check.peakFrequency = (float)grid.getFrequencies()[i];
+        }
+    }
+
+    forEachSection(coefficients, [&check](const CoefficientArray& section)
+    {
+        check.unstable = check.unstable || ! isStable(section);
+    });
+
+    check.clips = limits.inputPeakInDecibels + check.peakGainInDecibels > 0.f;
+    check.exceedsGainLimit = check.peakGainInDecibels > limits.maximumGainInDecibels;
+
+    return check;
+}
+
+std::vector<ResponseCheck> analyseFrequencyResponses(const std::vector<ChainSettings>& presets, const FrequencyGrid& grid,
+                                                     const ResponseLimits& limits,
+                                                     std::vector<FrequencyResponse>* responses,
+                                                     int numThreads)
+{
+    std::vector<ResponseCheck> checks(presets.size());
+
+    if (responses != nullptr)
+        responses->resize(presets.size());
+
+    std::atomic<size_t> nextPreset{ 0 };
+
+    const auto work = [&]
+    {
+        FrequencyResponse scratch;
+
+        for (;;)
+        {
+            const auto start = nextPreset.fetch_add(presetsPerTask);
+
+            if (start >= presets.size())
+                return;
+
+            for (auto i = start; i < std::min(start + presetsPerTask, presets.size()); ++i)
+            {
+                auto& response = responses != nullptr ? (*responses)[i] : scratch;
+                const auto coefficients = makeChainCoefficients(presets[i], grid.getSampleRate());
+
+                computeFrequencyResponse(coefficients, grid, response);
+                checks[i] = checkFrequencyResponse(response, grid, coefficients, limits);
+            }
+        }
+    };
+
+    if (numThreads <= 0)
+        numThreads = juce::SystemStats::getNumCpus();
+
+    // No more threads than there are tasks; the caller's thread is one of them
+    const auto numTasks = (presets.size() + presetsPerTask - 1) / presetsPerTask;
+    std::vector<std::thread> threads;
+
+    for (size_t i = 1; i < std::min((size_t)numThreads, numTasks); ++i)
+        threads.emplace_back(work);
+
+    work();
+
+    for (auto& thread : threads)
+        thread.join();
+
+    return checks;
+}
@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    FrequencyResponse.h
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+struct FrequencyResponse;
+
+// Frequencies to evaluate responses at, for one sample rate. The per-frequency
+// trigonometry is done once here and shared by every response on the grid.
+class FrequencyGrid
+{
+public:
+    FrequencyGrid(std::vector<double> frequencies, double sampleRate);
+
+    // numPoints frequencies spaced evenly on a log scale, both ends included
+    static FrequencyGrid logarithmic(int numPoints, double minimumFrequency, double maximumFrequency, double sampleRate);
+
+    size_t size() const noexcept { return frequencies.size(); }
+    double getSampleRate() const noexcept { return sampleRate; }
+    const std::vector<double>& getFrequencies() const noexcept { return frequencies; }
+
+private:
+    friend void computeFrequencyResponse(const ChainCoefficients&, const FrequencyGrid&, FrequencyResponse&);
+
+    std::vector<double> frequencies;
+    double sampleRate;
+
+    // cos and sin of w and 2w, w being each frequency in radians per sample
+    std::vector<double> cos1, sin1, cos2, sin2;
+};
+
+// A chain's response on a FrequencyGrid, one entry per grid point
+struct FrequencyResponse
+{
+    std::vector<float> magnitudeInDecibels;
+    std::vector<float> phaseInRadians;         // wrapped to [-pi, pi]
+    std::vector<float> groupDelayInSamples;
+};
+
+// Evaluates the product of the chain's second order sections directly from
+// their coefficients. SVF chains realise the same transfer functions, dynamic
+// bands are taken at rest. Depends only on its arguments, so any number of
+// threads can call it at once; result's vectors are reused when big enough.
+void computeFrequencyResponse(const ChainCoefficients& coefficients, const FrequencyGrid& grid, FrequencyResponse& result);
+FrequencyResponse computeFrequencyResponse(const ChainSettings& chainSettings, const FrequencyGrid& grid);
+
+struct ResponseLimits
+{
+    // Peak level of the material going in, in dBFS. A preset clips when its
+    // peak gain takes that above full scale.
+    float inputPeakInDecibels{ -6.f };
+
+    // Largest boost a preset may apply anywhere, bands combined
+    float maximumGainInDecibels{ 24.f };
+};
+
+struct ResponseCheck
+{
+    float peakGainInDecibels{ 0.f };
+    float peakFrequency{ 0.f };
+    bool clips{ false };
+    bool exceedsGainLimit{ false };
+    bool unstable{ false };
+
+    bool passes() const noexcept { return ! clips && ! exceedsGainLimit && ! unstable; }
+};
+
+// Peaks narrower than the grid spacing can be missed, use a dense enough grid
+ResponseCheck checkFrequencyResponse(const FrequencyResponse& response, const FrequencyGrid& grid,
+                                     const ChainCoefficients& coefficients, const ResponseLimits& limits);
+
+// Designs, evaluates and checks every preset, spread across numThreads threads
+// (0 for one per core). The responses are kept only if responses isn't null.
+std::vector<ResponseCheck> analyseFrequencyResponses(const std::vector<ChainSettings>& presets, const FrequencyGrid& grid,
+                                                     const ResponseLimits& limits,
+                                                     std::vector<FrequencyResponse>* responses = nullptr,
+                                                     int numThreads = 0);
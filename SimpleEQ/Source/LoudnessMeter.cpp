@@ -0,0 +1,278 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "LoudnessMeter.h"
+
+namespace
+{
+    constexpr auto minusInfinity = -std::numeric_limits<float>::infinity();
+
+    // Four independent sums, so the compiler can keep them in one SIMD register
+    double getSumOfSquares(const float* data, size_t numSamples) noexcept
+    {
+        float sums[4]{};
+        size_t i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+            for (size_t k = 0; k < 4; ++k)
+                sums[k] += data[i + k] * data[i + k];
+
+        for (; i < numSamples; ++i)
+            sums[0] += data[i] * data[i];
+
+        return (double)sums[0] + sums[1] + sums[2] + sums[3];
+    }
+
+    float getLoudness(double meanSquare) noexcept
+    {
+        return meanSquare > 0.0 ? (float)(-0.691 + 10.0 * std::log10(meanSquare)) : minusInfinity;
+    }
+}
+
+std::array<std::array<float, 6>, 2> makeKWeightingCoefficients(double sampleRate)
+{
+    // Constants from the 48 kHz reference design, re-derived for any rate
+    const auto pi = juce::MathConstants<double>::pi;
+
+    const auto shelfFrequency = 1681.974450955533;
+    const auto shelfGain = 3.999843853973347;
+    const auto shelfQ = 0.7071752369554196;
+
+    const auto K = std::tan(pi * shelfFrequency / sampleRate);
+    const auto Vh = std::pow(10.0, shelfGain / 20.0);
+    const auto Vb = std::pow(Vh, 0.4996667741545416);
+    const auto a0 = 1.0 + K / shelfQ + K * K;
+
+    const std::array<float, 6> preFilter
+    {
+        (float)((Vh + Vb * K / shelfQ + K * K) / a0),
+        (float)(2.0 * (K * K - Vh) / a0),
+        (float)((Vh - Vb * K / shelfQ + K * K) / a0),
+        1.f,
+        (float)(2.0 * (K * K - 1.0) / a0),
+        (float)((1.0 - K / shelfQ + K * K) / a0)
+    };
+
+    const auto highPassFrequency = 38.13547087602444;
+    const auto highPassQ = 0.5003270373238773;
+
+    const auto Kh = std::tan(pi * highPassFrequency / sampleRate);
+    const auto a0h = 1.0 + Kh / highPassQ + Kh * Kh;
+
+    const std::array<float, 6> highPass
+    {
+        1.f, -2.f, 1.f,
+        1.f,
+        (float)(2.0 * (Kh * Kh - 1.0) / a0h),
+        (float)((1.0 - Kh / highPassQ + Kh * Kh) / a0h)
+    };
+
+    return { preFilter, highPass };
+}
+
+LoudnessMeter::LoudnessMeter()
+    : momentaryLoudness(minusInfinity), shortTermLoudness(minusInfinity), integratedLoudness(minusInfinity)
+{
+    analysisThread->addTimeSliceClient(this);
+}
+
+LoudnessMeter::~LoudnessMeter()
+{
+    analysisThread->removeTimeSliceClient(this);
+}
+
+void LoudnessMeter::prepare(double sampleRate, int maximumBlockSize)
+{
+    const auto coefficients = makeKWeightingCoefficients(sampleRate);
+
+    for (int channel = 0; channel < maxChannels; ++channel)
+    {
+        *preFilters[channel].coefficients = coefficients[0];
+        *highPassFilters[channel].coefficients = coefficients[1];
+        preFilters[channel].reset();
+        highPassFilters[channel].reset();
+    }
+
+    scratch.setSize(1, juce::jmax(1, maximumBlockSize));
+
+    segmentLength = juce::jmax(1, juce::roundToInt(0.1 * sampleRate));
+    segmentPosition = 0;
+    segmentEnergy = 0.0;
+
+    resetRequested.store(true);
+}
+
+void LoudnessMeter::process(const juce::dsp::AudioBlock<const float>& block) noexcept
+{
+    const auto numChannels = juce::jmin((int)block.getNumChannels(), maxChannels);
+    const auto numSamples = (int)block.getNumSamples();
+    auto* weighted = scratch.getWritePointer(0);
+
+    for (int position = 0; position < numSamples;)
+    {
+        // Stop at segment ends and at the scratch size
+        const auto length = juce::jmin(numSamples - position, segmentLength - segmentPosition, scratch.getNumSamples());
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            preFilters[channel].processSamples(block.getChannelPointer((size_t)channel) + position, weighted, (size_t)length);
+            highPassFilters[channel].processSamples(weighted, weighted, (size_t)length);
+
+            // Channel weights are 1 for left and right
+            segmentEnergy += getSumOfSquares(weighted, (size_t)length);
+        }
+
+        position += length;
+        segmentPosition += length;
+
+        if (segmentPosition == segmentLength)
+            addSegment(segmentEnergy / segmentLength);
+    }
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        preFilters[channel].snapToZero();
+        highPassFilters[channel].snapToZero();
+    }
+}
+
+void LoudnessMeter::addSilence(int numSamples) noexcept
+{
+    for (int position = 0; position < numSamples;)
+    {
+        const auto length = juce::jmin(numSamples - position, segmentLength - segmentPosition);
+
+        position += length;
+        segmentPosition += length;
+
+        if (segmentPosition == segmentLength)
+            addSegment(segmentEnergy / segmentLength);
+    }
+}
+
+void LoudnessMeter::addSegment(double meanSquare) noexcept
+{
+    // If the analysis thread falls that far behind, the segment is lost
+    const auto scope = segmentFifo.write(1);
+
+    if (scope.blockSize1 > 0)
+        segments[(size_t)scope.startIndex1] = meanSquare;
+
+    segmentPosition = 0;
+    segmentEnergy = 0.0;
+}
+
+int LoudnessMeter::useTimeSlice()
+{
+    if (resetRequested.exchange(false))
+        resetAnalysis();
+
+    const auto numReady = segmentFifo.getNumReady();
+
+    if (numReady == 0)
+        return 20;
+
+    {
+        const auto scope = segmentFifo.read(numReady);
+
+        for (int i = 0; i < scope.blockSize1; ++i)
+            analyseSegment(segments[(size_t)(scope.startIndex1 + i)]);
+        for (int i = 0; i < scope.blockSize2; ++i)
+            analyseSegment(segments[(size_t)(scope.startIndex2 + i)]);
+    }
+
+    // Integrated loudness: mean energy of the blocks above the absolute gate,
+    // then again over those above the relative gate
+    double energy = 0.0;
+    int count = 0;
+
+    for (size_t bin = 0; bin < histogramEnergy.size(); ++bin)
+    {
+        energy += histogramEnergy[bin];
+        count += histogramCount[bin];
+    }
+
+    if (count == 0)
+    {
+        integratedLoudness.store(minusInfinity);
+        return 20;
+    }
+
+    const auto relativeGate = getLoudness(energy / count) - 10.f;
+    const auto firstBin = juce::jlimit(0, histogramSize, (int)std::ceil((relativeGate - absoluteGate) / histogramResolution));
+
+    energy = 0.0;
+    count = 0;
+
+    for (int bin = firstBin; bin < histogramSize; ++bin)
+    {
+        energy += histogramEnergy[(size_t)bin];
+        count += histogramCount[(size_t)bin];
+    }
+
+    integratedLoudness.store(count > 0 ? getLoudness(energy / count) : minusInfinity);
+    return 20;
+}
+
+void LoudnessMeter::analyseSegment(double meanSquare)
+{
+    recentSegments[(size_t)nextRecentSegment] = meanSquare;
+    nextRecentSegment = (nextRecentSegment + 1) % shortTermSegments;
+    numRecentSegments = juce::jmin(numRecentSegments + 1, shortTermSegments);
+
+    // Sums over the last n segments, newest first
+    const auto getMeanSquare = [this](int n)
+    {
+        double sum = 0.0;
+
+        for (int i = 1; i <= n; ++i)
+            sum += recentSegments[(size_t)((nextRecentSegment - i + shortTermSegments) % shortTermSegments)];
+
+        return sum / n;
+    };
+
+    if (numRecentSegments < momentarySegments)
+        return;
+
+    // 400 ms windows stepped by 100 ms are also the 75 % overlapping gating blocks
+    const auto momentary = getMeanSquare(momentarySegments);
+    const auto loudness = getLoudness(momentary);
+
+    momentaryLoudness.store(loudness);
+    shortTermLoudness.store(numRecentSegments == shortTermSegments ? getLoudness(getMeanSquare(shortTermSegments)) : minusInfinity);
+
+    if (loudness > absoluteGate)
+    {
+        // Allocated on first use, so instances that never meter stay small
+        if (histogramEnergy.empty())
+        {
+            histogramEnergy.resize((size_t)histogramSize);
+            histogramCount.resize((size_t)histogramSize);
+        }
+
+        const auto bin = juce::jmin(histogramSize - 1, (int)((loudness - absoluteGate) / histogramResolution));
+        histogramEnergy[(size_t)bin] += momentary;
+        ++histogramCount[(size_t)bin];
+    }
+}
+
+void LoudnessMeter::resetAnalysis()
+{
+    recentSegments.fill(0.0);
+    numRecentSegments = 0;
+    nextRecentSegment = 0;
+
+    std::fill(histogramEnergy.begin(), histogramEnergy.end(), 0.0);
+    std::fill(histogramCount.begin(), histogramCount.end(), 0);
+
+    momentaryLoudness.store(minusInfinity);
+    shortTermLoudness.store(minusInfinity);
+    integratedLoudness.store(minusInfinity);
+}
@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.h
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BlockBiquad.h"
+#include "AnalysisThread.h"
+
+// K-weighting pre-filter (high shelf) and RLB high-pass of ITU-R BS.1770-4,
+// as b0, b1, b2, a0, a1, a2 for the given sample rate
+std::array<std::array<float, 6>, 2> makeKWeightingCoefficients(double sampleRate);
+
+// ITU-R BS.1770-4 loudness of a mono or stereo signal.
+// The audio thread only K-weights the signal, with the same BlockBiquad engine
+// as the EQ stages, and sums its energy in 100 ms segments. The segments go
+// through a FIFO to a shared background thread, which does the windowing and
+// the gating for integrated loudness.
+class LoudnessMeter : private juce::TimeSliceClient
+{
+public:
+    LoudnessMeter();
+    ~LoudnessMeter() override;
+
+    void prepare(double sampleRate, int maximumBlockSize);
+
+    // Audio thread
+    void process(const juce::dsp::AudioBlock<const float>& block) noexcept;
+    void addSilence(int numSamples) noexcept;
+
+    // LUFS, minus infinity until there is something to measure. Any thread.
+    float getMomentaryLoudness() const noexcept { return momentaryLoudness.load(); }
+    float getShortTermLoudness() const noexcept { return shortTermLoudness.load(); }
+    float getIntegratedLoudness() const noexcept { return integratedLoudness.load(); }
+
+    // Starts a new integration, e.g. from a reset button
+    void resetIntegratedLoudness() noexcept { resetRequested.store(true); }
+
+    static constexpr int maxChannels = 2;
+
+private:
+    int useTimeSlice() override;
+    void addSegment(double meanSquare) noexcept;
+    void analyseSegment(double meanSquare);
+    void resetAnalysis();
+
+    juce::SharedResourcePointer<AnalysisThread> analysisThread;
+
+    // Audio thread state
+    BlockBiquad preFilters[maxChannels], highPassFilters[maxChannels];
+    juce::AudioBuffer<float> scratch;
+    int segmentLength{ 4800 };
+    int segmentPosition{ 0 };
+    double segmentEnergy{ 0 };
+
+    // 100 ms mean squares on their way to the analysis thread
+    static constexpr int segmentCapacity = 256;
+    juce::AbstractFifo segmentFifo{ segmentCapacity };
+    std::array<double, segmentCapacity> segments{};
+
+    // Analysis thread state
+    static constexpr int shortTermSegments = 30;
+    static constexpr int momentarySegments = 4;
+    std::array<double, shortTermSegments> recentSegments{};
+    int numRecentSegments{ 0 };
+    int nextRecentSegment{ 0 };
+
+    // Gating blocks above the absolute gate, binned by loudness in steps of
+    // histogramResolution LU, so integration never needs to keep every block
+    static constexpr float absoluteGate = -70.f;
+    static constexpr float histogramResolution = 0.01f;
+    static constexpr int histogramSize = 8000;
+    std::vector<double> histogramEnergy;
+    std::vector<int> histogramCount;
+
+    std::atomic<float> momentaryLoudness, shortTermLoudness, integratedLoudness;
+    std::atomic<bool> resetRequested{ true };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoudnessMeter)
+};
@@ -0,0 +1,456 @@
+/*
+  ==============================================================================
+
+    MatchEq.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "MatchEq.h"
+
+namespace
+{
+    // Everything the fit moves, frequencies and Qs in octaves (log2), gains in dB
+    enum FitParameter
+    {
+        Fit_HighPassFreq,
+        Fit_LowShelfFreq, Fit_LowShelfGain, Fit_LowShelfQ,
+        Fit_Peak1Freq, Fit_Peak1Gain, Fit_Peak1Q,
+        Fit_Peak2Freq, Fit_Peak2Gain, Fit_Peak2Q,
+        Fit_Peak3Freq, Fit_Peak3Gain, Fit_Peak3Q,
+        Fit_HighShelfFreq, Fit_HighShelfGain, Fit_HighShelfQ,
+        Fit_LowPassFreq,
+        numFitParameters
+    };
+
+    using FitVector = std::array<double, numFitParameters>;
+
+    constexpr int maximumIterations = 100;
+    constexpr float maximumGainInDecibels = 24.f;
+
+    // The plugin's parameter ranges, in fit units
+    struct Bounds
+    {
+        double minimum, maximum, step;
+    };
+
+    Bounds getBounds(int parameter)
+    {
+        const Bounds frequency{ std::log2(20.0), std::log2(20000.0), 0.01 };
+        const Bounds gain{ -maximumGainInDecibels, maximumGainInDecibels, 0.01 };
+        const Bounds shelfQ{ std::log2(0.1), std::log2(5.0), 0.01 };
+        const Bounds peakQ{ std::log2(0.1), std::log2(10.0), 0.01 };
+
+        switch (parameter)
+        {
+        case Fit_LowShelfGain: case Fit_Peak1Gain: case Fit_Peak2Gain: case Fit_Peak3Gain: case Fit_HighShelfGain:
+            return gain;
+        case Fit_LowShelfQ: case Fit_HighShelfQ:
+            return shelfQ;
+        case Fit_Peak1Q: case Fit_Peak2Q: case Fit_Peak3Q:
+            return peakQ;
+        default:
+            return frequency;
+        }
+    }
+
+    FitVector clampToBounds(FitVector x)
+    {
+        for (int p = 0; p < numFitParameters; ++p)
+            x[(size_t)p] = juce::jlimit(getBounds(p).minimum, getBounds(p).maximum, x[(size_t)p]);
+
+        return x;
+    }
+
+    FitVector toFitVector(const ChainSettings& s)
+    {
+        const auto octaves = [](float value) { return std::log2((double)juce::jmax(value, 1.0e-3f)); };
+
+        return clampToBounds({
+            octaves(s.highPassFreq),
+            octaves(s.lowShelfFreq), s.lowShelfGainInDecibels, octaves(s.lowShelfQ),
+            octaves(s.peakFreq[0]), s.peakGainInDecibels[0], octaves(s.peakQ[0]),
+            octaves(s.peakFreq[1]), s.peakGainInDecibels[1], octaves(s.peakQ[1]),
+            octaves(s.peakFreq[2]), s.peakGainInDecibels[2], octaves(s.peakQ[2]),
+            octaves(s.highShelfFreq), s.highShelfGainInDecibels, octaves(s.highShelfQ),
+            octaves(s.lowPassFreq)
+        });
+    }
+
+    ChainSettings toSettings(const FitVector& x, ChainSettings s)
+    {
+        const auto linear = [&x](int p) { return (float)std::exp2(x[(size_t)p]); };
+
+        s.highPassFreq = linear(Fit_HighPassFreq);
+        s.lowShelfFreq = linear(Fit_LowShelfFreq);
+        s.lowShelfGainInDecibels = (float)x[Fit_LowShelfGain];
+        s.lowShelfQ = linear(Fit_LowShelfQ);
+
+        for (int i = 0; i < 3; ++i)
+        {
+            s.peakFreq[i] = linear(Fit_Peak1Freq + 3 * i);
+            s.peakGainInDecibels[i] = (float)x[(size_t)(Fit_Peak1Gain + 3 * i)];
+            s.peakQ[i] = linear(Fit_Peak1Q + 3 * i);
+        }
+
+        s.highShelfFreq = linear(Fit_HighShelfFreq);
+        s.highShelfGainInDecibels = (float)x[Fit_HighShelfGain];
+        s.highShelfQ = linear(Fit_HighShelfQ);
+        s.lowPassFreq = linear(Fit_LowPassFreq);
+
+        return s;
+    }
+
+    // Weighted residuals of one candidate and their sum of squares
+    struct Evaluator
+    {
+        const MatchTarget& target;
+        const FrequencyGrid& grid;
+        const ChainSettings& base;
+        FrequencyResponse response;
+
+        double evaluate(const FitVector& x, std::vector<double>& residuals)
+        {
+            computeFrequencyResponse(makeChainCoefficients(toSettings(x, base), grid.getSampleRate()), grid, response);
+
+            residuals.resize(grid.size());
+            double cost = 0;
+
+            for (size_t i = 0; i < grid.size(); ++i)
+            {
+                residuals[i] = std::sqrt((double)target.weights[i])
+                             * ((double)response.magnitudeInDecibels[i] - target.gainInDecibels[i]);
+                cost += residuals[i] * residuals[i];
+            }
+
+            return cost;
+        }
+    };
+
+    // Solves a * x = b in place by Gaussian elimination with partial pivoting
+    bool solve(std::array<FitVector, numFitParameters>& a, FitVector& b)
+    {
+        constexpr auto n = (size_t)numFitParameters;
+
+        for (size_t column = 0; column < n; ++column)
+        {
+            auto pivot = column;
+
+            for (auto row = column + 1; row < n; ++row)
+                if (std::abs(a[row][column]) > std::abs(a[pivot][column]))
+                    pivot = row;
+
+            if (std::abs(a[pivot][column]) < 1.0e-300)
+                return false;
+
+            std::swap(a[column], a[pivot]);
+            std::swap(b[column], b[pivot]);
+
+            for (auto row = column + 1; row < n; ++row)
+            {
+                const auto factor = a[row][column] / a[column][column];
+
+                for (auto k = column; k < n; ++k)
+                    a[row][k] -= factor * a[column][k];
+
+                b[row] -= factor * b[column];
+            }
+        }
+
+        for (auto row = n; row-- > 0;)
+        {
+            for (auto k = row + 1; k < n; ++k)
+                b[row] -= a[row][k] * b[k];
+
+            b[row] /= a[row][row];
+        }
+
+        return true;
+    }
+
+    // Shelves from the average target at either end, then a peak at each of
+    // the three largest remaining deviations, at least an octave apart
+    FitVector makeInitialGuess(Evaluator& evaluator, const MatchTarget& target, const FrequencyGrid& grid)
+    {
+        auto x = toFitVector(evaluator.base);
+
+        x[Fit_HighPassFreq] = getBounds(Fit_HighPassFreq).minimum;
+        x[Fit_LowPassFreq] = getBounds(Fit_LowPassFreq).maximum;
+
+        const auto getMeanTarget = [&](double from, double to)
+        {
+            double sum = 0, weight = 0;
+
+            for (size_t i = 0; i < grid.size(); ++i)
+            {
+                if (grid.getFrequencies()[i] >= from && grid.getFrequencies()[i] <= to)
+                {
+                    sum += target.weights[i] * target.gainInDecibels[i];
+                    weight += target.weights[i];
+                }
+            }
+
+            return weight > 0 ? sum / weight : 0.0;
+        };
+
+        x[Fit_LowShelfFreq] = std::log2(100.0);
+        x[Fit_LowShelfGain] = getMeanTarget(20.0, 100.0);
+        x[Fit_LowShelfQ] = std::log2(0.71);
+        x[Fit_HighShelfFreq] = std::log2(8000.0);
+        x[Fit_HighShelfGain] = getMeanTarget(8000.0, 20000.0);
+        x[Fit_HighShelfQ] = std::log2(0.71);
+
+        for (int peak = 0; peak < 3; ++peak)
+        {
+            x[(size_t)(Fit_Peak1Gain + 3 * peak)] = 0.0;
+            x[(size_t)(Fit_Peak1Q + 3 * peak)] = 0.0;
+        }
+
+        std::vector<double> residuals;
+
+        for (int peak = 0; peak < 3; ++peak)
+        {
+            evaluator.evaluate(clampToBounds(x), residuals);
+
+            auto best = grid.size();
+
+            for (size_t i = 0; i < grid.size(); ++i)
+            {
+                const auto octave = std::log2(grid.getFrequencies()[i]);
+                auto farEnough = true;
+
+                for (int other = 0; other < peak; ++other)
+                    farEnough = farEnough && std::abs(octave - x[(size_t)(Fit_Peak1Freq + 3 * other)]) >= 1.0;
+
+                if (farEnough && (best == grid.size() || std::abs(residuals[i]) > std::abs(residuals[best])))
+                    best = i;
+            }
+
+            if (best == grid.size())
+                break;
+
+            const auto weight = juce::jmax(1.0e-6, std::sqrt((double)target.weights[best]));
+
+            x[(size_t)(Fit_Peak1Freq + 3 * peak)] = std::log2(grid.getFrequencies()[best]);
+            x[(size_t)(Fit_Peak1Gain + 3 * peak)] = -residuals[best] / weight;
+        }
+
+        return clampToBounds(x);
+    }
+}
+
+MatchTarget makeMatchTarget(const std::vector<float>& referencePower, const std::vector<float>& currentPower,
+                            int fftSize, const FrequencyGrid& grid)
+{
+    MatchTarget target;
+    target.gainInDecibels.resize(grid.size());
+    target.weights.resize(grid.size());
+
+    const auto numBins = (int)juce::jmin(referencePower.size(), currentPower.size());
+    const auto binWidth = grid.getSampleRate() / fftSize;
+    const auto halfBand = std::exp2(1.0 / 6.0);
+
+    std::vector<double> reference(grid.size()), current(grid.size());
+
+    for (size_t i = 0; i < grid.size(); ++i)
+    {
+        const auto frequency = grid.getFrequencies()[i];
+
+        // Every bin within a third of an octave, or at least the nearest one
+        auto first = (int)std::ceil(frequency / halfBand / binWidth);
+        auto last = (int)std::floor(frequency * halfBand / binWidth);
+
+        if (last < first)
+            first = last = juce::roundToInt(frequency / binWidth);
+
+        first = juce::jlimit(0, numBins - 1, first);
+        last = juce::jlimit(first, numBins - 1, last);
+
+        for (auto bin = first; bin <= last; ++bin)
+        {
+            reference[i] += referencePower[(size_t)bin];
+            current[i] += currentPower[(size_t)bin];
+        }
+
+        reference[i] = 10.0 * std::log10(reference[i] / (last - first + 1) + 1.0e-30);
+        current[i] = 10.0 * std::log10(current[i] / (last - first + 1) + 1.0e-30);
+    }
+
+    // Ignore whatever is 60 dB below either spectrum's loudest band
+    const auto referenceFloor = *std::max_element(reference.begin(), reference.end()) - 60.0;
+    const auto currentFloor = *std::max_element(current.begin(), current.end()) - 60.0;
+
+    double sum = 0, weight = 0;
+
+    for (size_t i = 0; i < grid.size(); ++i)
+    {
+        const auto usable = reference[i] > referenceFloor && current[i] > currentFloor
+                         && grid.getFrequencies()[i] < 0.45 * grid.getSampleRate();
+
+        target.weights[i] = usable ? 1.f : 0.f;
+        sum += target.weights[i] * (reference[i] - current[i]);
+        weight += target.weights[i];
+    }
+
+    const auto levelDifference = weight > 0 ? sum / weight : 0.0;
+
+    for (size_t i = 0; i < grid.size(); ++i)
+        target.gainInDecibels[i] = target.weights[i] > 0
+            ? juce::jlimit(-maximumGainInDecibels, maximumGainInDecibels, (float)(reference[i] - current[i] - levelDifference))
+            : 0.f;
+
+    return target;
+}
+
+MatchResult fitMatchEq(const MatchTarget& target, const FrequencyGrid& grid, const ChainSettings& initial,
+                       const std::function<bool()>& shouldStop)
+{
+    const auto start = juce::Time::getMillisecondCounterHiRes();
+
+    Evaluator evaluator{ target, grid, initial, {} };
+    std::vector<double> residuals, candidateResiduals, shifted;
+
+    auto x = makeInitialGuess(evaluator, target, grid);
+    auto cost = evaluator.evaluate(x, residuals);
+    auto damping = 1.0e-3;
+
+    MatchResult result;
+    std::vector<FitVector> jacobian(grid.size());
+
+    for (; result.numIterations < maximumIterations; ++result.numIterations)
+    {
+        if (shouldStop && shouldStop())
+            break;
+
+        // Forward-difference Jacobian, stepping inwards at the bounds
+        for (int p = 0; p < numFitParameters; ++p)
+        {
+            const auto bounds = getBounds(p);
+            auto shiftedX = x;
+            const auto delta = x[(size_t)p] + bounds.step > bounds.maximum ? -bounds.step : bounds.step;
+
+            shiftedX[(size_t)p] += delta;
+            evaluator.evaluate(shiftedX, shifted);
+
+            for (size_t i = 0; i < grid.size(); ++i)
+                jacobian[i][(size_t)p] = (shifted[i] - residuals[i]) / delta;
+        }
+
+        std::array<FitVector, numFitParameters> normal{};
+        FitVector gradient{};
+
+        for (size_t i = 0; i < grid.size(); ++i)
+        {
+            for (size_t p = 0; p < (size_t)numFitParameters; ++p)
+            {
+                gradient[p] += jacobian[i][p] * residuals[i];
+
+                for (size_t q = 0; q < (size_t)numFitParameters; ++q)
+                    normal[p][q] += jacobian[i][p] * jacobian[i][q];
+            }
+        }
+
+        // Raise the damping until a step goes downhill
+        auto improved = false;
+        auto previousCost = cost;
+
+        for (int attempt = 0; attempt < 10 && ! improved; ++attempt)
+        {
+            auto a = normal;
+            FitVector step;
+
+            for (size_t p = 0; p < (size_t)numFitParameters; ++p)
+            {
+                a[p][p] += damping * (normal[p][p] + 1.0e-9);
+                step[p] = -gradient[p];
+            }
+
+            if (! solve(a, step))
+            {
+                damping *= 4.0;
+                continue;
+            }
+
+            FitVector candidate;
+
+            for (size_t p = 0; p < (size_t)numFitParameters; ++p)
+                candidate[p] = x[p] + step[p];
+
+            candidate = clampToBounds(candidate);
+            const auto candidateCost = evaluator.evaluate(candidate, candidateResiduals);
+
+            if (candidateCost < cost)
+            {
+                x = candidate;
+                cost = candidateCost;
+                std::swap(residuals, candidateResiduals);
+                damping = juce::jmax(damping / 3.0, 1.0e-7);
+                improved = true;
+            }
+            else
+            {
+                damping *= 4.0;
+            }
+        }
+
+        if (! improved || previousCost - cost < 1.0e-6 * previousCost)
+            break;
+    }
+
+    double totalWeight = 0;
+
+    for (auto weight : target.weights)
+        totalWeight += weight;
+
+    result.settings = toSettings(x, initial);
+    result.rmsErrorInDecibels = totalWeight > 0 ? (float)std::sqrt(cost / totalWeight) : 0.f;
+    result.milliseconds = juce::Time::getMillisecondCounterHiRes() - start;
+
+    return result;
+}
+
+MatchEqFitter::MatchEqFitter()
+    : juce::Thread("Match EQ fit")
+{
+}
+
+MatchEqFitter::~MatchEqFitter()
+{
+    stopThread(2000);
+}
+
+void MatchEqFitter::start(const std::vector<float>& referencePower, const std::vector<float>& currentPower,
+                          int newFftSize, double newSampleRate, const ChainSettings& initial)
+{
+    // The fit checks threadShouldExit() every iteration, so this is quick
+    stopThread(2000);
+
+    reference = referencePower;
+    current = currentPower;
+    fftSize = newFftSize;
+    sampleRate = newSampleRate;
+    initialSettings = initial;
+
+    startThread(juce::Thread::Priority::low);
+}
+
+std::optional<MatchResult> MatchEqFitter::takeResult()
+{
+    const juce::ScopedLock lock(resultLock);
+    return std::exchange(result, std::nullopt);
+}
+
+void MatchEqFitter::run()
+{
+    const auto grid = FrequencyGrid::logarithmic(numGridPoints, 20.0, juce::jmin(20000.0, 0.45 * sampleRate), sampleRate);
+    const auto target = makeMatchTarget(reference, current, fftSize, grid);
+    const auto fit = fitMatchEq(target, grid, initialSettings, [this] { return threadShouldExit(); });
+
+    if (threadShouldExit())
+        return;
+
+    const juce::ScopedLock lock(resultLock);
+    result = fit;
+}
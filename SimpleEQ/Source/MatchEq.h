@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    MatchEq.h
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "FrequencyResponse.h"
+
+// What the bands should do, in dB on a frequency grid, with a weight per point
+struct MatchTarget
+{
+    std::vector<float> gainInDecibels;
+    std::vector<float> weights;
+};
+
+// Third-octave smoothed difference between two average power spectra, as
+// produced by SpectrumAnalyzer, at the grid's frequencies. The overall level
+// difference is removed, matching is about tone. Points where either spectrum
+// has next to no energy get no weight.
+MatchTarget makeMatchTarget(const std::vector<float>& referencePower, const std::vector<float>& currentPower,
+                            int fftSize, const FrequencyGrid& grid);
+
+struct MatchResult
+{
+    ChainSettings settings;
+    float rmsErrorInDecibels{ 0.f };
+    int numIterations{ 0 };
+    double milliseconds{ 0 };
+};
+
+// Fits the frequencies, gains and Qs of the seven bands to the target with
+// Levenberg-Marquardt, every evaluation going through computeFrequencyResponse.
+// Slopes, topology and dynamics stay as in initial. Checks shouldStop between
+// iterations.
+MatchResult fitMatchEq(const MatchTarget& target, const FrequencyGrid& grid, const ChainSettings& initial,
+                       const std::function<bool()>& shouldStop = {});
+
+// Runs fitMatchEq on its own thread, so neither the UI nor the audio thread
+// ever waits for it. Start and collect the result from the message thread.
+class MatchEqFitter : private juce::Thread
+{
+public:
+    MatchEqFitter();
+    ~MatchEqFitter() override;
+
+    // Cancels a fit in progress and starts again with these inputs
+    void start(const std::vector<float>& referencePower, const std::vector<float>& currentPower,
+               int fftSize, double sampleRate, const ChainSettings& initial);
+
+    bool isFitting() const { return isThreadRunning(); }
+
+    // The last completed fit, if it hasn't been taken yet
+    std::optional<MatchResult> takeResult();
+
+    // Fit grid: 1/12 octave from 20 Hz to 20 kHz
+    static constexpr int numGridPoints = 121;
+
+private:
+    void run() override;
+
+    std::vector<float> reference, current;
+    int fftSize{ 0 };
+    double sampleRate{ 44100.0 };
+    ChainSettings initialSettings;
+
+    juce::CriticalSection resultLock;
+    std::optional<MatchResult> result;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MatchEqFitter)
+};
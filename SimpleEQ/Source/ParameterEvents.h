@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    ParameterEvents.h
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+struct ParameterEvent
+{
+    int sampleOffset{ 0 };      // relative to the start of the next processBlock
+    int parameterIndex{ 0 };    // index into AudioProcessor::getParameters()
+    float value{ 0 };           // denormalised, e.g. Hz or dB
+};
+
+// Single producer / single consumer queue of automation events.
+// Events must be pushed in ascending sampleOffset order; the consumer drains
+// the queue every block, so the order restarts once it is empty.
+struct ParameterEventQueue
+{
+    // Rejects an event earlier than the last one still queued, it would
+    // otherwise be applied late together with everything before it
+    bool push(const ParameterEvent& event) noexcept
+    {
+        if (! isEmpty() && event.sampleOffset < lastPushedOffset)
+        {
+            jassertfalse;
+            return false;
+        }
+
+        const auto scope = fifo.write(1);
+
+        if (scope.blockSize1 == 0)
+            return false;
+
+        events[(size_t)scope.startIndex1] = event;
+        lastPushedOffset = event.sampleOffset;
+        return true;
+    }
+
+    bool isEmpty() const noexcept
+    {
+        return fifo.getNumReady() == 0;
+    }
+
+    const ParameterEvent& front() const noexcept
+    {
+        jassert(! isEmpty());
+
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(1, start1, size1, start2, size2);
+
+        return events[(size_t)start1];
+    }
+
+    void pop() noexcept
+    {
+        fifo.finishedRead(1);
+    }
+
+    static constexpr int capacity = 1024;
+
+private:
+    juce::AbstractFifo fifo{ capacity };
+    std::array<ParameterEvent, capacity> events;
+    int lastPushedOffset{ 0 };    // producer side only
+};
@@ -9,6 +9,40 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+namespace
+{
+    // Responses are published from the audio thread, so with the audio stopped
+    // nothing arrives. After this many ticks without one the curve is designed
+    // from the parameters instead.
+    constexpr int ticksBeforeParameterFallback = 2;
+
+    // Before the first prepareToPlay there's no rate to go by
+    constexpr double fallbackSampleRate = 44100.0;
+
+    // Grids only depend on the width and the rate. Message thread only.
+    std::shared_ptr<const FrequencyGrid> getSharedGrid(int numPoints, double sampleRate)
+    {
+        static std::map<std::pair<int, double>, std::weak_ptr<const FrequencyGrid>> grids;
+
+        auto& entry = grids[{ numPoints, sampleRate }];
+
+        if (auto grid = entry.lock())
+            return grid;
+
+        auto grid = std::make_shared<const FrequencyGrid>(FrequencyGrid::logarithmic(numPoints, 20.0, 20000.0, sampleRate));
+        entry = grid;
+
+        return grid;
+    }
+
+    // Only needed while painting, so every editor shares one
+    FrequencyResponse& getPaintResponse()
+    {
+        static FrequencyResponse response;
+        return response;
+    }
+}
+
 ResponseCurveComponent::ResponseCurveComponent(SimpleEQAudioProcessor& p) : audioProcessor(p)
 {
     const auto& params = audioProcessor.getParameters();
@@ -17,6 +51,11 @@ ResponseCurveComponent::ResponseCurveComponent(SimpleEQAudioProcessor& p) : audi
         param->addListener(this);
     }
 
+    responseVersion = audioProcessor.readResponse(response);
+
+    if (responseVersion == 0)
+        updateFromParameters();
+
     startTimerHz(60);
 }
 
@@ -36,35 +75,36 @@ void ResponseCurveComponent::parameterValueChanged(int parameterIndex, float new
 
 void ResponseCurveComponent::timerCallback()
 {
-    if (parametersChanged.compareAndSetBool(false, true))
+    // A single atomic load per tick while nothing changes
+    if (audioProcessor.getResponseVersion() != responseVersion)
     {
-        // Update the monochain
-        auto chainSettings = getChainSettings(audioProcessor.apvts);
-        // HighPass
-        auto highPassCoefficients = makeHighPassFilter(chainSettings, audioProcessor.getSampleRate());
-        updateCutFilter(monoChain.get < ChainPositions::HighPass>(), highPassCoefficients, chainSettings.highPassSlope);
-        // LowShelf
-        auto lowShelfCoefficients = makeLowShelfFilter(chainSettings, audioProcessor.getSampleRate());
-        updateCoefficients(monoChain.get < ChainPositions::LowShelf>().coefficients, lowShelfCoefficients);
-        // Peak 1
-        auto peakCoefficients1 = makePeakFilter(chainSettings, audioProcessor.getSampleRate(), 0);
-        updateCoefficients(monoChain.get < ChainPositions::Peak1>().coefficients, peakCoefficients1);
-        // Peak 2
-        auto peakCoefficients2 = makePeakFilter(chainSettings, audioProcessor.getSampleRate(), 1);
-        updateCoefficients(monoChain.get < ChainPositions::Peak2>().coefficients, peakCoefficients2);
-        // Peak 3
-        auto peakCoefficients3 = makePeakFilter(chainSettings, audioProcessor.getSampleRate(), 2);
-        updateCoefficients(monoChain.get < ChainPositions::Peak3>().coefficients, peakCoefficients3);
-        // HighShelf
-        auto highShelfCoefficients = makeHighShelfFilter(chainSettings, audioProcessor.getSampleRate());
-        updateCoefficients(monoChain.get < ChainPositions::HighShelf>().coefficients, highShelfCoefficients);
-        // LowPass
-        auto lowPassCoefficients = makeLowPassFilter(chainSettings, audioProcessor.getSampleRate());
-        updateCutFilter(monoChain.get < ChainPositions::LowPass>(), lowPassCoefficients, chainSettings.lowPassSlope);
+        responseVersion = audioProcessor.readResponse(response);
+        parametersChanged.set(false);
+        ticksSinceParameterChange = 0;
 
         // Signal a repaint
         repaint();
+        return;
     }
+
+    if (! parametersChanged.get() || ++ticksSinceParameterChange < ticksBeforeParameterFallback)
+        return;
+
+    parametersChanged.set(false);
+    ticksSinceParameterChange = 0;
+
+    updateFromParameters();
+    repaint();
+}
+
+void ResponseCurveComponent::updateFromParameters()
+{
+    if (response.sampleRate <= 0.0)
+        response.sampleRate = audioProcessor.getSampleRate() > 0.0 ? audioProcessor.getSampleRate() : fallbackSampleRate;
+
+    // Only the first set of bands, as the processor would run them linked
+    response.stereoMode = StereoMode::StereoMode_Linked;
+    response.coefficients[0] = makeChainCoefficients(getChainSettings(audioProcessor.apvts), response.sampleRate);
 }
 
 void ResponseCurveComponent::paint(juce::Graphics& g)
@@ -77,62 +117,14 @@ void ResponseCurveComponent::paint(juce::Graphics& g)
 
     auto w = responseArea.getWidth();
 
-    auto& highpass = monoChain.get<ChainPositions::HighPass>();
-    auto& lowshelf = monoChain.get<ChainPositions::LowShelf>();
-    auto& peak1 = monoChain.get<ChainPositions::Peak1>();
-    auto& peak2 = monoChain.get<ChainPositions::Peak2>();
-    auto& peak3 = monoChain.get<ChainPositions::Peak3>();
-    auto& highshelf = monoChain.get<ChainPositions::HighShelf>();
-    auto& lowpass = monoChain.get<ChainPositions::LowPass>();
-
-    auto sampleRate = audioProcessor.getSampleRate();
-
-    std::vector<double> mags;
+    g.setColour(Colours::orange);
+    g.drawRoundedRectangle(responseArea.toFloat(), 4.f, 1.f);
 
-    mags.resize(w);
-    for (int i = 0; i < w; ++i)
-    {
-        double mag = 1.f;
-        auto freq = mapToLog10(double(i) / double(w), 20.0, 20000.0);
-
-        // HighPass
-        if (!highpass.isBypassed<0>())
-            mag *= highpass.get<0>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if (!highpass.isBypassed<1>())
-            mag *= highpass.get<1>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if (!highpass.isBypassed<2>())
-            mag *= highpass.get<2>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if (!highpass.isBypassed<3>())
-            mag *= highpass.get<3>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        // LowShelf
-        if (!monoChain.isBypassed<ChainPositions::LowShelf>())
-            mag *= lowshelf.coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        // Peak 1
-        if (!monoChain.isBypassed<ChainPositions::Peak1>())
-            mag *= peak1.coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        // Peak 2
-        if (!monoChain.isBypassed<ChainPositions::Peak2>())
-            mag *= peak2.coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        // Peak 3
-        if (!monoChain.isBypassed<ChainPositions::Peak3>())
-            mag *= peak3.coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        // HighShelf
-        if (!monoChain.isBypassed<ChainPositions::HighShelf>())
-            mag *= highshelf.coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        // LowPass
-        if (!lowpass.isBypassed<0>())
-            mag *= lowpass.get<0>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if (!lowpass.isBypassed<1>())
-            mag *= lowpass.get<1>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if (!lowpass.isBypassed<2>())
-            mag *= lowpass.get<2>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if (!lowpass.isBypassed<3>())
-            mag *= lowpass.get<3>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-
-        mags[i] = Decibels::gainToDecibels(mag);
-    }
+    if (w < 2)
+        return;
 
-    Path responseCurve;
+    if (grid == nullptr || (int)grid->size() != w || grid->getSampleRate() != response.sampleRate)
+        grid = getSharedGrid(w, response.sampleRate);
 
     const double outputMin = responseArea.getBottom();
     const double outputMax = responseArea.getY();
@@ -141,18 +133,118 @@ void ResponseCurveComponent::paint(juce::Graphics& g)
         return jmap(input, -30.0, 30.0, outputMin, outputMax);
     };
 
-    responseCurve.startNewSubPath(responseArea.getX(), map(mags.front()));
+    auto drawCurve = [&](const ChainCoefficients& coefficients, Colour colour)
+    {
+        auto& magnitudes = getPaintResponse().magnitudeInDecibels;
+        computeFrequencyResponse(coefficients, *grid, getPaintResponse());
+
+        Path responseCurve;
+
+        responseCurve.startNewSubPath(responseArea.getX(), map(magnitudes.front()));
+
+        for (size_t i = 1; i < grid->size(); ++i)
+        {
+            responseCurve.lineTo(responseArea.getX() + i, map(magnitudes[i]));
+        }
 
-    for (size_t i = 1; i < mags.size(); ++i)
+        g.setColour(colour);
+        g.strokePath(responseCurve, PathStrokeType(2.f));
+    };
+
+    // The second chain behind the first when they filter differently
+    if (response.stereoMode != StereoMode::StereoMode_Linked)
+        drawCurve(response.coefficients[1], Colours::lightblue);
+
+    drawCurve(response.coefficients[0], Colours::white);
+}
+
+MatchEqComponent::MatchEqComponent(SimpleEQAudioProcessor& p) : audioProcessor(p)
+{
+    captureReferenceButton.onClick = [this] { toggleCapture(SpectrumAnalyzer::Slot_Reference); };
+    captureCurrentButton.onClick = [this] { toggleCapture(SpectrumAnalyzer::Slot_Current); };
+    fitButton.onClick = [this] { startFit(); };
+
+    statusLabel.setJustificationType(juce::Justification::centredLeft);
+
+    for (auto* comp : std::initializer_list<juce::Component*>{ &captureReferenceButton, &captureCurrentButton, &fitButton, &statusLabel })
+        addAndMakeVisible(comp);
+
+    updateButtons();
+    startTimerHz(10);
+}
+
+MatchEqComponent::~MatchEqComponent()
+{
+    // A capture nobody can stop anymore would keep the analyzer busy
+    if (capturingSlot >= 0)
+        audioProcessor.getMatchAnalyzer().stopCapture();
+}
+
+void MatchEqComponent::toggleCapture(SpectrumAnalyzer::Slot slot)
+{
+    auto& analyzer = audioProcessor.getMatchAnalyzer();
+
+    if (capturingSlot == slot)
     {
-        responseCurve.lineTo(responseArea.getX() + i, map(mags[i]));
+        analyzer.stopCapture();
+        capturingSlot = -1;
+        statusLabel.setText("Captured", juce::dontSendNotification);
+    }
+    else
+    {
+        analyzer.startCapture(slot);
+        capturingSlot = slot;
+        statusLabel.setText(slot == SpectrumAnalyzer::Slot_Reference ? "Capturing reference..." : "Capturing current...",
+                            juce::dontSendNotification);
     }
 
-    g.setColour(Colours::orange);
-    g.drawRoundedRectangle(responseArea.toFloat(), 4.f, 1.f);
+    updateButtons();
+}
+
+void MatchEqComponent::startFit()
+{
+    if (capturingSlot >= 0)
+    {
+        audioProcessor.getMatchAnalyzer().stopCapture();
+        capturingSlot = -1;
+    }
+
+    fitPending = audioProcessor.startMatchFit();
+    statusLabel.setText(fitPending ? "Fitting..." : "Capture both first", juce::dontSendNotification);
+
+    updateButtons();
+}
+
+void MatchEqComponent::timerCallback()
+{
+    if (! fitPending || audioProcessor.isMatchFitRunning())
+        return;
+
+    fitPending = false;
+    statusLabel.setText(audioProcessor.applyMatchFit() ? "Applied" : "Fit failed", juce::dontSendNotification);
+
+    updateButtons();
+}
+
+void MatchEqComponent::updateButtons()
+{
+    captureReferenceButton.setButtonText(capturingSlot == SpectrumAnalyzer::Slot_Reference ? "Stop Reference" : "Capture Reference");
+    captureCurrentButton.setButtonText(capturingSlot == SpectrumAnalyzer::Slot_Current ? "Stop Current" : "Capture Current");
+
+    captureReferenceButton.setEnabled(! fitPending);
+    captureCurrentButton.setEnabled(! fitPending);
+    fitButton.setEnabled(! fitPending);
+}
+
+void MatchEqComponent::resized()
+{
+    auto bounds = getLocalBounds().reduced(2);
+    const auto buttonWidth = bounds.getWidth() / 6;
 
-    g.setColour(Colours::white);
-    g.strokePath(responseCurve, PathStrokeType(2.f));
+    captureReferenceButton.setBounds(bounds.removeFromLeft(buttonWidth).reduced(2, 0));
+    captureCurrentButton.setBounds(bounds.removeFromLeft(buttonWidth).reduced(2, 0));
+    fitButton.setBounds(bounds.removeFromLeft(buttonWidth).reduced(2, 0));
+    statusLabel.setBounds(bounds);
 }
 
 //==============================================================================
@@ -160,6 +252,8 @@ SimpleEQAudioProcessorEditor::SimpleEQAudioProcessorEditor (SimpleEQAudioProcess
     : AudioProcessorEditor (&p), audioProcessor (p),
     // ResponseCurveComponent
     responseCurveComponent(audioProcessor),
+    // Match EQ
+    matchEqComponent(audioProcessor),
     // HighPass
     highPassFreqSliderAttachment(audioProcessor.apvts, "HighPass Freq", highPassFreqSlider),
     highPassSlopeSliderAttachment(audioProcessor.apvts, "HighPass Slope", highPassSlopeSlider),
@@ -217,6 +311,7 @@ void SimpleEQAudioProcessorEditor::resized()
     auto responseArea = bounds.removeFromTop(bounds.getHeight() * 0.33);
 
     responseCurveComponent.setBounds(responseArea);
+    matchEqComponent.setBounds(bounds.removeFromTop(30));
 
     // Set up areas
     auto highPassArea = bounds.removeFromLeft(bounds.getWidth() * 1 / 7);
@@ -278,6 +373,7 @@ std::vector<juce::Component*> SimpleEQAudioProcessorEditor::getComps()
         &highShelfFreqSlider,
         &highShelfGainSlider,
         &highShelfQSlider,
-        &responseCurveComponent
+        &responseCurveComponent,
+        &matchEqComponent
     };
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "FrequencyResponse.h"
 
 struct CustomRotarySlider : juce::Slider
 {
@@ -36,10 +37,47 @@ struct ResponseCurveComponent : juce::Component,
 
     void paint(juce::Graphics& g) override;
 private:
+    void updateFromParameters();
+
     SimpleEQAudioProcessor& audioProcessor;
     juce::Atomic<bool> parametersChanged{ false };
+    int ticksSinceParameterChange{ 0 };
+
+    // Copied from the processor when its version moves, nothing is designed here
+    SimpleEQAudioProcessor::PublishedResponse response;
+    juce::uint32 responseVersion{ 0 };
+
+    // Shared with every other editor of the same width at the same rate
+    std::shared_ptr<const FrequencyGrid> grid;
+};
+
+// Match EQ: capture a reference and the current material, then fit the
+// first set of bands to the difference. The fit runs in the background and
+// is applied from the timer once it's done.
+struct MatchEqComponent : juce::Component,
+    juce::Timer
+{
+    MatchEqComponent(SimpleEQAudioProcessor&);
+    ~MatchEqComponent();
+
+    void timerCallback() override;
+
+    void resized() override;
+private:
+    void toggleCapture(SpectrumAnalyzer::Slot slot);
+    void startFit();
+    void updateButtons();
+
+    SimpleEQAudioProcessor& audioProcessor;
+
+    juce::TextButton captureReferenceButton{ "Capture Reference" },
+        captureCurrentButton{ "Capture Current" },
+        fitButton{ "Match" };
+    juce::Label statusLabel;
 
-    MonoChain monoChain;
+    // Which slot this component started capturing into, -1 when none
+    int capturingSlot{ -1 };
+    bool fitPending{ false };
 };
 
 //==============================================================================
@@ -106,6 +144,7 @@ private:
         highShelfQSliderAttachment;
 
     ResponseCurveComponent responseCurveComponent;
+    MatchEqComponent matchEqComponent;
 
     std::vector<juce::Component*> getComps();
 
@@ -8,6 +8,72 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "MatchEq.h"
+#include "Crossover.h"
+
+namespace
+{
+	// Maps a parameter to the ChainSettings field it drives and the bands it dirties
+	struct ParameterTarget
+	{
+		const char* parameterID;
+		juce::uint32 bands;
+		void (*apply)(ChainSettings&, float);
+	};
+
+	const ParameterTarget parameterTargetTable[] =
+	{
+		{ "HighPass Freq", getBandMask(ChainPositions::HighPass), [](ChainSettings& s, float v) { s.highPassFreq = v; } },
+		{ "HighPass Slope", getBandMask(ChainPositions::HighPass), [](ChainSettings& s, float v) { s.highPassSlope = static_cast<Slope>((int)v); } },
+		{ "LowPass Freq", getBandMask(ChainPositions::LowPass), [](ChainSettings& s, float v) { s.lowPassFreq = v; } },
+		{ "LowPass Slope", getBandMask(ChainPositions::LowPass), [](ChainSettings& s, float v) { s.lowPassSlope = static_cast<Slope>((int)v); } },
+		{ "LowShelf Freq", getBandMask(ChainPositions::LowShelf), [](ChainSettings& s, float v) { s.lowShelfFreq = v; } },
+		{ "LowShelf Gain", getBandMask(ChainPositions::LowShelf), [](ChainSettings& s, float v) { s.lowShelfGainInDecibels = v; } },
+		{ "LowShelf Q", getBandMask(ChainPositions::LowShelf), [](ChainSettings& s, float v) { s.lowShelfQ = v; } },
+		{ "HighShelf Freq", getBandMask(ChainPositions::HighShelf), [](ChainSettings& s, float v) { s.highShelfFreq = v; } },
+		{ "HighShelf Gain", getBandMask(ChainPositions::HighShelf), [](ChainSettings& s, float v) { s.highShelfGainInDecibels = v; } },
+		{ "HighShelf Q", getBandMask(ChainPositions::HighShelf), [](ChainSettings& s, float v) { s.highShelfQ = v; } },
+		{ "Peak 1 Freq", getBandMask(ChainPositions::Peak1), [](ChainSettings& s, float v) { s.peakFreq[0] = v; } },
+		{ "Peak 1 Gain", getBandMask(ChainPositions::Peak1), [](ChainSettings& s, float v) { s.peakGainInDecibels[0] = v; } },
+		{ "Peak 1 Q", getBandMask(ChainPositions::Peak1), [](ChainSettings& s, float v) { s.peakQ[0] = v; } },
+		{ "Peak 2 Freq", getBandMask(ChainPositions::Peak2), [](ChainSettings& s, float v) { s.peakFreq[1] = v; } },
+		{ "Peak 2 Gain", getBandMask(ChainPositions::Peak2), [](ChainSettings& s, float v) { s.peakGainInDecibels[1] = v; } },
+		{ "Peak 2 Q", getBandMask(ChainPositions::Peak2), [](ChainSettings& s, float v) { s.peakQ[1] = v; } },
+		{ "Peak 3 Freq", getBandMask(ChainPositions::Peak3), [](ChainSettings& s, float v) { s.peakFreq[2] = v; } },
+		{ "Peak 3 Gain", getBandMask(ChainPositions::Peak3), [](ChainSettings& s, float v) { s.peakGainInDecibels[2] = v; } },
+		{ "Peak 3 Q", getBandMask(ChainPositions::Peak3), [](ChainSettings& s, float v) { s.peakQ[2] = v; } },
+		{ "Filter Topology", allBands, [](ChainSettings& s, float v) { s.topology = static_cast<Topology>((int)v); } },
+		// Dynamics only move the detectors, the static design doesn't depend on them
+		{ "LowShelf Dynamic", 0, [](ChainSettings& s, float v) { s.dynamics[0].enabled = v > 0.5f; } },
+		{ "LowShelf Threshold", 0, [](ChainSettings& s, float v) { s.dynamics[0].thresholdInDecibels = v; } },
+		{ "LowShelf Ratio", 0, [](ChainSettings& s, float v) { s.dynamics[0].ratio = v; } },
+		{ "LowShelf Attack", 0, [](ChainSettings& s, float v) { s.dynamics[0].attackInMilliseconds = v; } },
+		{ "LowShelf Release", 0, [](ChainSettings& s, float v) { s.dynamics[0].releaseInMilliseconds = v; } },
+		{ "Peak 1 Dynamic", 0, [](ChainSettings& s, float v) { s.dynamics[1].enabled = v > 0.5f; } },
+		{ "Peak 1 Threshold", 0, [](ChainSettings& s, float v) { s.dynamics[1].thresholdInDecibels = v; } },
+		{ "Peak 1 Ratio", 0, [](ChainSettings& s, float v) { s.dynamics[1].ratio = v; } },
+		{ "Peak 1 Attack", 0, [](ChainSettings& s, float v) { s.dynamics[1].attackInMilliseconds = v; } },
+		{ "Peak 1 Release", 0, [](ChainSettings& s, float v) { s.dynamics[1].releaseInMilliseconds = v; } },
+		{ "Peak 2 Dynamic", 0, [](ChainSettings& s, float v) { s.dynamics[2].enabled = v > 0.5f; } },
+		{ "Peak 2 Threshold", 0, [](ChainSettings& s, float v) { s.dynamics[2].thresholdInDecibels = v; } },
+		{ "Peak 2 Ratio", 0, [](ChainSettings& s, float v) { s.dynamics[2].ratio = v; } },
+		{ "Peak 2 Attack", 0, [](ChainSettings& s, float v) { s.dynamics[2].attackInMilliseconds = v; } },
+		{ "Peak 2 Release", 0, [](ChainSettings& s, float v) { s.dynamics[2].releaseInMilliseconds = v; } },
+		{ "Peak 3 Dynamic", 0, [](ChainSettings& s, float v) { s.dynamics[3].enabled = v > 0.5f; } },
+		{ "Peak 3 Threshold", 0, [](ChainSettings& s, float v) { s.dynamics[3].thresholdInDecibels = v; } },
+		{ "Peak 3 Ratio", 0, [](ChainSettings& s, float v) { s.dynamics[3].ratio = v; } },
+		{ "Peak 3 Attack", 0, [](ChainSettings& s, float v) { s.dynamics[3].attackInMilliseconds = v; } },
+		{ "Peak 3 Release", 0, [](ChainSettings& s, float v) { s.dynamics[3].releaseInMilliseconds = v; } },
+		{ "HighShelf Dynamic", 0, [](ChainSettings& s, float v) { s.dynamics[4].enabled = v > 0.5f; } },
+		{ "HighShelf Threshold", 0, [](ChainSettings& s, float v) { s.dynamics[4].thresholdInDecibels = v; } },
+		{ "HighShelf Ratio", 0, [](ChainSettings& s, float v) { s.dynamics[4].ratio = v; } },
+		{ "HighShelf Attack", 0, [](ChainSettings& s, float v) { s.dynamics[4].attackInMilliseconds = v; } },
+		{ "HighShelf Release", 0, [](ChainSettings& s, float v) { s.dynamics[4].releaseInMilliseconds = v; } },
+	};
+
+	// Parameter ID prefixes of the dynamic bands, in chain order
+	const char* const dynamicBandNames[numDynamicBands] = { "LowShelf", "Peak 1", "Peak 2", "Peak 3", "HighShelf" };
+}
 
 //==============================================================================
 SimpleEQAudioProcessor::SimpleEQAudioProcessor()
@@ -18,10 +84,67 @@ SimpleEQAudioProcessor::SimpleEQAudioProcessor()
 		.withInput("Input", juce::AudioChannelSet::stereo(), true)
 #endif
 		.withOutput("Output", juce::AudioChannelSet::stereo(), true)
+		// Crossover bands, for parallel processing in the host
+		.withOutput("Band 1", juce::AudioChannelSet::stereo(), false)
+		.withOutput("Band 2", juce::AudioChannelSet::stereo(), false)
+		.withOutput("Band 3", juce::AudioChannelSet::stereo(), false)
+		.withOutput("Band 4", juce::AudioChannelSet::stereo(), false)
 #endif
 	)
 #endif
 {
+	chainParameters[0].attach(apvts, {});
+	chainParameters[1].attach(apvts, secondChainSuffix);
+	stereoModeParameter = apvts.getRawParameterValue("Stereo Mode");
+	loudnessMeterParameter = apvts.getRawParameterValue("Loudness Meter");
+	autoGainParameter = apvts.getRawParameterValue("Auto Gain");
+	morphParameter = apvts.getRawParameterValue("Morph");
+	morphEnabledParameter = apvts.getRawParameterValue("Morph Enabled");
+	morphFromParameter = apvts.getRawParameterValue("Morph From");
+	morphToParameter = apvts.getRawParameterValue("Morph To");
+	oversamplingParameter = apvts.getRawParameterValue("Oversampling");
+	oversamplingFilterParameter = apvts.getRawParameterValue("Oversampling Filter");
+	matchFitter = std::make_unique<MatchEqFitter>();
+	crossover = std::make_unique<Crossover>();
+	crossoverParameters = std::make_unique<CrossoverParameters>();
+	crossoverParameters->attach(apvts);
+
+	// Integer latency, so hosts can compensate it exactly
+	for (size_t factor = 0; factor < 2; ++factor)
+	{
+		oversamplers[factor][0] = std::make_unique<juce::dsp::Oversampling<float>>(
+			2, factor + 1, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true, true);
+		oversamplers[factor][1] = std::make_unique<juce::dsp::Oversampling<float>>(
+			2, factor + 1, juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple, true, true);
+	}
+
+	// Resolve parameter indices once so automation events never compare strings
+	for (auto* parameter : getParameters())
+	{
+		ParameterTargetIndex index;
+
+		if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+		{
+			for (int i = 0; i < (int)std::size(parameterTargetTable); ++i)
+			{
+				const juce::String parameterID{ parameterTargetTable[i].parameterID };
+
+				if (ranged->paramID == parameterID)
+				{
+					// Parameters without a second set, like the topology, drive both chains
+					index.target = i;
+					index.chain = apvts.getParameter(parameterID + secondChainSuffix) != nullptr ? 0 : -1;
+				}
+				else if (ranged->paramID == parameterID + secondChainSuffix)
+				{
+					index.target = i;
+					index.chain = 1;
+				}
+			}
+		}
+
+		parameterTargets.push_back(index);
+	}
 }
 
 SimpleEQAudioProcessor::~SimpleEQAudioProcessor()
@@ -63,7 +186,7 @@ bool SimpleEQAudioProcessor::isMidiEffect() const
 
 double SimpleEQAudioProcessor::getTailLengthSeconds() const
 {
-	return 0.0;
+	return tailLengthSeconds.load();
 }
 
 int SimpleEQAudioProcessor::getNumPrograms()
@@ -106,7 +229,68 @@ void SimpleEQAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBloc
 	leftChain.prepare(spec);
 	rightChain.prepare(spec);
 
+	leftSvfChain.prepare(spec);
+	rightSvfChain.prepare(spec);
+
+	oversamplingBlockSize = juce::jmax(1, samplesPerBlock);
+
+	for (auto& factor : oversamplers)
+		for (auto& oversampler : factor)
+			oversampler->initProcessing((size_t)oversamplingBlockSize);
+
+	// Prepared for the highest factor, lower ones only use part of it
+	spec.sampleRate = sampleRate * 4.0;
+	spec.maximumBlockSize = (juce::uint32)samplesPerBlock * 4;
+	leftOversampledChain.prepare(spec);
+	rightOversampledChain.prepare(spec);
+
+	for (auto& detector : detectors)
+		detector.prepare(sampleRate);
+
+	detectorsValid = false;
+
+	inputMeter.prepare(sampleRate, samplesPerBlock);
+	outputMeter.prepare(sampleRate, samplesPerBlock);
+	matchAnalyzer.prepare(sampleRate);
+	crossover->prepare(sampleRate, samplesPerBlock);
+	crossover->setSettings(crossoverParameters->load());
+
+	autoGain.reset(sampleRate, autoGainRampLengthInSeconds);
+	autoGain.setCurrentAndTargetValue(juce::Decibels::decibelsToGain(autoGainTargetInDecibels));
+
+	// Snapshot coefficients are only valid at the rate they were designed for
+	{
+		const juce::SpinLock::ScopedLockType lock(snapshotLock);
+
+		for (auto& snapshot : snapshots)
+			if (snapshot.valid)
+				designSnapshot(snapshot, sampleRate);
+	}
+
+	currentMorph = -1.f;
+
+	// Shared with every other instance at these rates
+	coefficientTables = CoefficientTables::get(sampleRate);
+	oversampledCoefficientTables[0] = CoefficientTables::get(sampleRate * 2.0);
+	oversampledCoefficientTables[1] = CoefficientTables::get(sampleRate * 4.0);
+
 	updateFilters();
+
+	// Called here the host picks up the latency straight away
+	updateOversampling(true);
+	cancelPendingUpdate();
+	setLatencySamples(oversamplingLatency.load());
+
+	// Start from the current settings instead of gliding in from the defaults
+	leftSvfChain.reset();
+	rightSvfChain.reset();
+
+	tailLengthValid = false;
+	updateTailLength();
+	silentSamples = 0;
+	skippingSilence = false;
+
+	publishResponse();
 }
 
 void SimpleEQAudioProcessor::releaseResources()
@@ -136,6 +320,11 @@ bool SimpleEQAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts)
 		return false;
 #endif
 
+	// Band outputs are either off or shaped like the main one
+	for (int bus = 1; bus < layouts.outputBuses.size(); ++bus)
+		if (! layouts.outputBuses[bus].isDisabled() && layouts.outputBuses[bus] != layouts.getMainOutputChannelSet())
+			return false;
+
 	return true;
 #endif
 }
@@ -156,344 +345,1989 @@ void SimpleEQAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
 	for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
 		buffer.clear(i, 0, buffer.getNumSamples());
 
-	updateFilters();
+	// With the band outputs enabled the buffer holds their channels too, the
+	// EQ itself only ever sees the main bus
+	auto mainBuffer = getBusBuffer(buffer, false, 0);
+	juce::dsp::AudioBlock<float> block(mainBuffer);
+
+	// Switching modes changes what each chain filters, so start both from scratch
+	if (const auto stereoMode = static_cast<StereoMode>((int)stereoModeParameter->load()); stereoMode != currentStereoMode)
+	{
+		currentStereoMode = stereoMode;
+		resetChains();
+		applyStereoSettings(getTargetSettings(), { allBands, allBands });
+	}
 
-	juce::dsp::AudioBlock<float> block(buffer);
+	// The latency can only be changed from the message thread
+	if (updateOversampling(false))
+		triggerAsyncUpdate();
 
-	auto leftBlock = block.getSingleChannelBlock(0);
-	auto rightBlock = block.getSingleChannelBlock(1);
+	const auto morphEnabled = morphEnabledParameter->load() > 0.5f;
+	auto morphing = false;
+	auto snapshotsAvailable = false;
 
-	juce::dsp::ProcessContextReplacing<float> leftContext(leftBlock);
-	juce::dsp::ProcessContextReplacing<float> rightContext(rightBlock);
+	// Snapshots are only swapped in while snapshotLock is held, see storeSnapshot.
+	// It's only held here to take out what this block needs, so the message
+	// thread never waits for the filtering.
+	{
+		const juce::SpinLock::ScopedTryLockType snapshotScope(snapshotLock);
+		snapshotsAvailable = snapshotScope.isLocked();
+
+		if (snapshotsAvailable)
+		{
+			// A recalled snapshot brings its own coefficients, so there's nothing to redesign
+			if (const auto slot = pendingRecall.exchange(-1); slot >= 0)
+				applySnapshot(snapshots[(size_t)slot]);
+
+			if (morphEnabled)
+			{
+				const auto& from = snapshots[(size_t)morphFromParameter->load()];
+				const auto& to = snapshots[(size_t)morphToParameter->load()];
+
+				if (from.valid && to.valid)
+				{
+					morphFrom = { from.settings, from.coefficients };
+					morphTo = { to.settings, to.coefficients };
+					morphing = true;
+				}
+			}
+		}
+	}
 
-	leftChain.process(leftContext);
-	rightChain.process(rightContext);
-}
+	if (snapshotsChanged.exchange(false))
+		currentMorph = -1.f;
 
-//==============================================================================
-bool SimpleEQAudioProcessor::hasEditor() const
-{
-	return true; // (change this to false if you choose to not supply an editor)
-}
+	const auto targetSettings = getTargetSettings();
+	updateDetectors(targetSettings);
 
-juce::AudioProcessorEditor* SimpleEQAudioProcessor::createEditor()
-{
-	return new SimpleEQAudioProcessorEditor(*this);
-	//return new juce::GenericAudioProcessorEditor(*this);
+	if (! morphing)
+		currentMorph = -1.f;
+
+	// Auto gain needs both meters; with neither on, metering costs two loads
+	const auto autoGainEnabled = autoGainParameter->load() > 0.5f;
+	const auto metering = autoGainEnabled || loudnessMeterParameter->load() > 0.5f;
+
+	// The crossover ringing counts towards the tail too
+	if (crossover->setSettings(crossoverParameters->load()))
+		tailLengthValid = false;
+
+	// Does nothing unless a match EQ capture is running
+	matchAnalyzer.push(block);
+
+	// Once the input is silent and the filters have rung out, skip the DSP entirely
+	const auto inputIsSilent = mainBuffer.getMagnitude(0, mainBuffer.getNumSamples()) < silenceThreshold;
+	const auto hasRungOut = inputIsSilent && silentSamples >= tailLengthSamples;
+	silentSamples = inputIsSilent ? juce::jmin(silentSamples + mainBuffer.getNumSamples(), 1 << 30) : 0;
+
+	if (hasRungOut)
+	{
+		if (! skippingSilence)
+		{
+			// Whatever is left in the states is below threshold, start clean later
+			resetChains();
+			skippingSilence = true;
+		}
+
+		while (! parameterEvents.isEmpty())
+			parameterEvents.pop();
+
+		// Morphing picks up where it was once the input returns
+		if (morphing)
+			currentMorph = -1.f;
+		else
+			applyStereoSettings(targetSettings, getChangedStereoBands(targetSettings));
+
+		if (metering)
+		{
+			inputMeter.addSilence(mainBuffer.getNumSamples());
+			outputMeter.addSilence(mainBuffer.getNumSamples());
+		}
+
+		updateTailLength();
+		publishResponse();
+		return;
+	}
+
+	skippingSilence = false;
+
+	if (metering)
+		inputMeter.process(block);
+
+	if (morphing)
+	{
+		// The topology parameter still applies while morphing
+		if (targetSettings[0].topology != currentTopology)
+		{
+			currentTopology = targetSettings[0].topology;
+			resetChains();
+			currentMorph = -1.f;
+		}
+
+		processWithMorph(block, morphFrom, morphTo, morphParameter->load());
+	}
+	else if (morphEnabled && ! snapshotsAvailable)
+	{
+		// A snapshot is being stored right now, hold the current coefficients
+		processSubBlock(block);
+	}
+	else
+	{
+		processWithAutomation(block, targetSettings);
+	}
+
+	if (crossover->getNumBands() > 1)
+	{
+		juce::dsp::AudioBlock<float> buses(buffer);
+		std::array<juce::dsp::AudioBlock<float>, maxCrossoverBands> auxOutputs;
+
+		for (int band = 0; band < maxCrossoverBands; ++band)
+		{
+			if (auto* bus = getBus(false, 1 + band); bus != nullptr && bus->isEnabled())
+				auxOutputs[(size_t)band] = buses.getSubsetChannelBlock((size_t)getChannelIndexInProcessBlockBuffer(false, 1 + band, 0),
+																	   (size_t)bus->getNumberOfChannels());
+		}
+
+		crossover->process(block, auxOutputs);
+	}
+
+	updateTailLength();
+	publishResponse();
+
+	// Measured before the auto gain, which would otherwise chase itself
+	if (metering)
+		outputMeter.process(block);
+
+	applyAutoGain(mainBuffer, autoGainEnabled);
 }
 
-//==============================================================================
-void SimpleEQAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
+void SimpleEQAudioProcessor::applyAutoGain(juce::AudioBuffer<float>& buffer, bool enabled)
 {
-	// You should use this method to store your parameters in the memory block.
-	// You could do that either as raw data, or use the XML or ValueTree classes
-	// as intermediaries to make it easy to save and load complex data.
+	if (! enabled)
+	{
+		if (autoGainTargetInDecibels != 0.f)
+		{
+			autoGainTargetInDecibels = 0.f;
+			autoGain.setCurrentAndTargetValue(1.f);
+			autoGainInDecibels.store(0.f);
+		}
+
+		return;
+	}
+
+	const auto input = inputMeter.getShortTermLoudness();
+	const auto output = outputMeter.getShortTermLoudness();
+
+	// Hold the last correction while either side is too quiet to measure
+	if (input > -70.f && output > -70.f)
+	{
+		const auto target = juce::jlimit(-maximumAutoGainInDecibels, maximumAutoGainInDecibels, input - output);
+
+		if (std::abs(target - autoGainTargetInDecibels) > 0.01f)
+		{
+			autoGainTargetInDecibels = target;
+			autoGain.setTargetValue(juce::Decibels::decibelsToGain(target));
+			autoGainInDecibels.store(target);
+		}
+	}
 
-	juce::MemoryOutputStream mos(destData, true);
-	apvts.state.writeToStream(mos);
+	if (autoGain.isSmoothing() || autoGain.getTargetValue() != 1.f)
+		autoGain.applyGain(buffer, buffer.getNumSamples());
 }
 
-void SimpleEQAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
+void SimpleEQAudioProcessor::processWithAutomation(juce::dsp::AudioBlock<float>& block, const StereoSettings& targetSettings)
 {
-	// You should use this method to restore your parameters from this memory block,
-	// whose contents will have been created by the getStateInformation() call.
-	auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
-	if (tree.isValid() )
+	const auto numSamples = (int)block.getNumSamples();
+	auto position = 0;
+
+	if (! parameterEvents.isEmpty())
 	{
-		apvts.replaceState(tree);
-		updateFilters();
+		// Sample-accurate path: split wherever an event lands, but never into
+		// sub-blocks shorter than automationGranularity
+		auto settings = appliedSettings;
+
+		while (position < numSamples)
+		{
+			StereoBands bands{};
+
+			while (! parameterEvents.isEmpty() && parameterEvents.front().sampleOffset <= position)
+			{
+				const auto eventBands = applyParameterEvent(parameterEvents.front(), settings);
+				bands[0] |= eventBands[0];
+				bands[1] |= eventBands[1];
+				parameterEvents.pop();
+			}
+
+			if ((bands[0] | bands[1]) != 0)
+				applyStereoSettings(settings, bands);
+
+			auto end = numSamples;
+
+			if (! parameterEvents.isEmpty())
+				end = juce::jmin(numSamples, juce::jmax(position + automationGranularity, parameterEvents.front().sampleOffset));
+
+			auto subBlock = block.getSubBlock((size_t)position, (size_t)(end - position));
+			processSubBlock(subBlock);
+
+			position = end;
+		}
+
+		// Events past the end of the block are covered by the parameters' final
+		// values, which also pick up anything changed without an event
+		while (! parameterEvents.isEmpty())
+			parameterEvents.pop();
+
+		applyStereoSettings(targetSettings, getChangedStereoBands(targetSettings));
+		return;
+	}
+
+	const auto changedBands = getChangedStereoBands(targetSettings);
+
+	if ((changedBands[0] | changedBands[1]) != 0
+		&& currentTopology == Topology::Topology_Biquad
+		&& targetSettings[0].topology == Topology::Topology_Biquad)
+	{
+		// Internal smoothing path: ramp the changed bands across the block instead
+		// of stepping at its start. The SVF topology glides on its own.
+		const auto startSettings = appliedSettings;
+
+		while (position < numSamples)
+		{
+			const auto end = juce::jmin(numSamples, position + automationGranularity);
+			const auto proportion = (float)end / (float)numSamples;
+
+			applyStereoSettings({ interpolateChainSettings(startSettings[0], targetSettings[0], proportion),
+								   interpolateChainSettings(startSettings[1], targetSettings[1], proportion) },
+								 changedBands);
+
+			auto subBlock = block.getSubBlock((size_t)position, (size_t)(end - position));
+			processSubBlock(subBlock);
+
+			position = end;
+		}
+
+		return;
 	}
+
+	applyStereoSettings(targetSettings, changedBands);
+	processSubBlock(block);
 }
 
-ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts)
+void SimpleEQAudioProcessor::processWithMorph(juce::dsp::AudioBlock<float>& block, const MorphEndpoint& from, const MorphEndpoint& to, float morph)
 {
-	ChainSettings settings;
+	// The morph overrides the band parameters, and with them their events
+	while (! parameterEvents.isEmpty())
+		parameterEvents.pop();
 
-	// HighPass
-	settings.highPassFreq = apvts.getRawParameterValue("HighPass Freq")->load();
-	settings.highPassSlope = static_cast<Slope>(apvts.getRawParameterValue("HighPass Slope")->load());
-	// LowPass
-	settings.lowPassFreq = apvts.getRawParameterValue("LowPass Freq")->load();
-	settings.lowPassSlope = static_cast<Slope>(apvts.getRawParameterValue("LowPass Slope")->load());
-	// LowShelf
-	settings.lowShelfFreq = apvts.getRawParameterValue("LowShelf Freq")->load();
-	settings.lowShelfGainInDecibels = apvts.getRawParameterValue("LowShelf Gain")->load();
-	settings.lowShelfQ = apvts.getRawParameterValue("LowShelf Q")->load();
-	// HighShelf
-	settings.highShelfFreq = apvts.getRawParameterValue("HighShelf Freq")->load();
-	settings.highShelfGainInDecibels = apvts.getRawParameterValue("HighShelf Gain")->load();
-	settings.highShelfQ = apvts.getRawParameterValue("HighShelf Q")->load();
-	// Peak 1
-	settings.peakFreq[0] = apvts.getRawParameterValue("Peak 1 Freq")->load();
-	settings.peakGainInDecibels[0] = apvts.getRawParameterValue("Peak 1 Gain")->load();
-	settings.peakQ[0] = apvts.getRawParameterValue("Peak 1 Q")->load();
-	// Peak 2
-	settings.peakFreq[1] = apvts.getRawParameterValue("Peak 2 Freq")->load();
-	settings.peakGainInDecibels[1] = apvts.getRawParameterValue("Peak 2 Gain")->load();
-	settings.peakQ[1] = apvts.getRawParameterValue("Peak 2 Q")->load();
-	// Peak 3
-	settings.peakFreq[2] = apvts.getRawParameterValue("Peak 3 Freq")->load();
-	settings.peakGainInDecibels[2] = apvts.getRawParameterValue("Peak 3 Gain")->load();
-	settings.peakQ[2] = apvts.getRawParameterValue("Peak 3 Q")->load();
-	
-	return settings;
+	const auto numSamples = (int)block.getNumSamples();
+	const auto start = currentMorph < 0.f ? morph : currentMorph;
+	auto position = 0;
+
+	// Ramp towards the new amount at the automation granularity
+	while (position < numSamples)
+	{
+		const auto end = juce::jmin(numSamples, position + automationGranularity);
+		const auto proportion = juce::jmap((float)end / (float)numSamples, start, morph);
+
+		if (proportion != currentMorph)
+			applyMorph(from, to, proportion);
+
+		auto subBlock = block.getSubBlock((size_t)position, (size_t)(end - position));
+		processSubBlock(subBlock);
+
+		position = end;
+	}
 }
 
-// Update Coefficients
-void updateCoefficients(Coefficients& old, const Coefficients& replacements)
+void SimpleEQAudioProcessor::applyMorph(const MorphEndpoint& from, const MorphEndpoint& to, float proportion)
 {
-	*old = *replacements;
+	for (int chain = 0; chain < 2; ++chain)
+	{
+		auto settings = interpolateChainSettings(from.settings[chain], to.settings[chain], proportion);
+		settings.topology = currentTopology;
+
+		if (currentTopology == Topology::Topology_Svf)
+			updateSvfFilters(settings, allBands, chain == 0 ? Channel_Left : Channel_Right);
+		else
+			applyChainCoefficients(chain == 0 ? leftChain : rightChain,
+								   interpolateChainCoefficients(from.coefficients[chain], to.coefficients[chain], proportion));
+
+		// Only close to the morphed response, but good enough for the tail and the detectors
+		appliedSettings[chain] = settings;
+	}
+
+	// The snapshot designs carry no gain reduction, the dynamics put it back
+	for (auto& reductions : gainReduction)
+		std::fill(std::begin(reductions), std::end(reductions), 0.f);
+
+	currentMorph = proportion;
 }
 
-Coefficients makePeakFilter(const ChainSettings& chainSettings, double sampleRate, int filterNr)
+void SimpleEQAudioProcessor::applySnapshot(const Snapshot& snapshot)
 {
-	return juce::dsp::IIR::Coefficients<float>::makePeakFilter(
-		sampleRate,
-		chainSettings.peakFreq[filterNr],
-		chainSettings.peakQ[filterNr],
-		juce::Decibels::decibelsToGain(chainSettings.peakGainInDecibels[filterNr]));
+	// Anything else is left to the regular redesign
+	if (! snapshot.valid
+		|| snapshot.stereoMode != currentStereoMode
+		|| snapshot.settings[0].topology != Topology::Topology_Biquad
+		|| currentTopology != Topology::Topology_Biquad)
+		return;
+
+	applyChainCoefficients(leftChain, snapshot.coefficients[0]);
+	applyChainCoefficients(rightChain, snapshot.coefficients[1]);
+	appliedSettings = snapshot.settings;
+
+	for (auto& reductions : gainReduction)
+		std::fill(std::begin(reductions), std::end(reductions), 0.f);
 }
 
-// Peak Filters
-void SimpleEQAudioProcessor::updatePeakFilter(const ChainSettings& chainSettings, int filterNr)
+void SimpleEQAudioProcessor::storeSnapshot(int slot)
 {
-	auto peakCoefficients = makePeakFilter(chainSettings, getSampleRate(), filterNr);
+	jassert(juce::isPositiveAndBelow(slot, numSnapshots));
+
+	Snapshot snapshot;
+	snapshot.valid = true;
+
+	for (auto* parameter : getParameters())
+		snapshot.parameterValues.push_back(parameter->getValue());
+
+	snapshot.stereoMode = static_cast<StereoMode>((int)stereoModeParameter->load());
+	snapshot.settings = getSettingsFromParameterValues(snapshot.parameterValues, snapshot.stereoMode);
+	designSnapshot(snapshot, getSampleRate());
 
-	if (filterNr == 0)
+	// Only a swap under the lock, the old snapshot is freed after it
 	{
-		updateCoefficients(leftChain.get<ChainPositions::Peak1>().coefficients, peakCoefficients);
-		updateCoefficients(rightChain.get<ChainPositions::Peak1>().coefficients, peakCoefficients);
+		const juce::SpinLock::ScopedLockType lock(snapshotLock);
+		std::swap(snapshots[(size_t)slot], snapshot);
 	}
-	else if (filterNr == 1)
+
+	snapshotsChanged.store(true);
+}
+
+bool SimpleEQAudioProcessor::recallSnapshot(int slot)
+{
+	jassert(juce::isPositiveAndBelow(slot, numSnapshots));
+
+	std::vector<float> values;
+
 	{
-		updateCoefficients(leftChain.get<ChainPositions::Peak2>().coefficients, peakCoefficients);
-		updateCoefficients(rightChain.get<ChainPositions::Peak2>().coefficients, peakCoefficients);
+		const juce::SpinLock::ScopedLockType lock(snapshotLock);
+
+		if (! snapshots[(size_t)slot].valid)
+			return false;
+
+		values = snapshots[(size_t)slot].parameterValues;
 	}
-	else if (filterNr == 2)
+
+	const auto& parameters = getParameters();
+	auto* stereoMode = apvts.getParameter("Stereo Mode");
+
+	// Band parameters and the stereo mode only, metering and morph controls stay
+	for (int i = 0; i < parameters.size(); ++i)
 	{
-		updateCoefficients(leftChain.get<ChainPositions::Peak3>().coefficients, peakCoefficients);
-		updateCoefficients(rightChain.get<ChainPositions::Peak3>().coefficients, peakCoefficients);
+		auto* parameter = parameters[i];
+
+		if (parameterTargets[(size_t)i].target < 0 && parameter != stereoMode)
+			continue;
+
+		if (parameter->getValue() != values[(size_t)i])
+		{
+			parameter->beginChangeGesture();
+			parameter->setValueNotifyingHost(values[(size_t)i]);
+			parameter->endChangeGesture();
+		}
 	}
 
+	// After the parameters, so the next block finds nothing left to change
+	pendingRecall.store(slot);
+	return true;
 }
 
-// High Pass Filter
-void SimpleEQAudioProcessor::updateHighPassFilters(const ChainSettings& chainSettings)
+bool SimpleEQAudioProcessor::hasSnapshot(int slot) const
 {
-	auto highPassCoefficients = makeHighPassFilter(chainSettings, getSampleRate());
+	if (! juce::isPositiveAndBelow(slot, numSnapshots))
+		return false;
 
-	auto& leftHighPass = leftChain.get<ChainPositions::HighPass>();
-	auto& rightHighPass = rightChain.get<ChainPositions::HighPass>();
-	updateCutFilter(leftHighPass, highPassCoefficients, chainSettings.highPassSlope);
-	updateCutFilter(rightHighPass, highPassCoefficients, chainSettings.highPassSlope);
+	const juce::SpinLock::ScopedLockType lock(snapshotLock);
+	return snapshots[(size_t)slot].valid;
 }
 
-// Low Pass Filter
-void SimpleEQAudioProcessor::updateLowPassFilters(const ChainSettings& chainSettings)
-{	
-	auto lowPassCoefficients = makeLowPassFilter(chainSettings, getSampleRate());
+StereoSettings SimpleEQAudioProcessor::getSettingsFromParameterValues(const std::vector<float>& parameterValues, StereoMode stereoMode) const
+{
+	StereoSettings settings;
+	const auto& parameters = getParameters();
 
-	auto& leftLowPass = leftChain.get<ChainPositions::LowPass>();
-	auto& rightLowPass = rightChain.get<ChainPositions::LowPass>();
-	updateCutFilter(leftLowPass, lowPassCoefficients, chainSettings.lowPassSlope);
-	updateCutFilter(rightLowPass, lowPassCoefficients, chainSettings.lowPassSlope);
-}
+	for (int i = 0; i < parameters.size(); ++i)
+	{
+		const auto& index = parameterTargets[(size_t)i];
 
-Coefficients makeLowShelfFilter(const ChainSettings& chainSettings, double sampleRate)
-{
-	return juce::dsp::IIR::Coefficients<float>::makeLowShelf(
-		sampleRate,
-		chainSettings.lowShelfFreq,
-		chainSettings.lowShelfQ,
-		juce::Decibels::decibelsToGain(chainSettings.lowShelfGainInDecibels));
-}
+		if (index.target < 0)
+			continue;
 
-// Low Shelf Filter
-void SimpleEQAudioProcessor::updateLowShelfFilters(const ChainSettings& chainSettings)
-{	
-	auto lowShelfCoefficients = makeLowShelfFilter(chainSettings, getSampleRate());
+		auto* ranged = static_cast<juce::RangedAudioParameter*>(parameters[i]);
+		const auto value = ranged->convertFrom0to1(parameterValues[(size_t)i]);
+		const auto& target = parameterTargetTable[index.target];
+
+		if (index.chain != 1)
+			target.apply(settings[0], value);
+		if (index.chain != 0)
+			target.apply(settings[1], value);
+	}
+
+	if (stereoMode == StereoMode::StereoMode_Linked)
+		settings[1] = settings[0];
 
-	updateCoefficients(leftChain.get<ChainPositions::LowShelf>().coefficients, lowShelfCoefficients);
-	updateCoefficients(rightChain.get<ChainPositions::LowShelf>().coefficients, lowShelfCoefficients);
+	return settings;
 }
 
-Coefficients makeHighShelfFilter(const ChainSettings& chainSettings, double sampleRate)
+void SimpleEQAudioProcessor::designSnapshot(Snapshot& snapshot, double sampleRate) const
 {
-	return juce::dsp::IIR::Coefficients<float>::makeHighShelf(
-		sampleRate,
-		chainSettings.highShelfFreq,
-		chainSettings.highShelfQ,
-		juce::Decibels::decibelsToGain(chainSettings.highShelfGainInDecibels));
+	if (sampleRate <= 0.0)
+		sampleRate = 44100.0;
+
+	for (size_t chain = 0; chain < 2; ++chain)
+		snapshot.coefficients[chain] = makeChainCoefficients(snapshot.settings[chain], sampleRate);
 }
 
-// High Shelf
-void SimpleEQAudioProcessor::updateHighShelfFilters(const ChainSettings& chainSettings)
+bool SimpleEQAudioProcessor::addParameterEvent(int sampleOffset, int parameterIndex, float newValue)
 {
-	auto highShelfCoefficients = makeHighShelfFilter(chainSettings, getSampleRate());
+	if (! juce::isPositiveAndBelow(parameterIndex, (int)parameterTargets.size()) || parameterTargets[(size_t)parameterIndex].target < 0)
+		return false;
 
-	updateCoefficients(leftChain.get<ChainPositions::HighShelf>().coefficients, highShelfCoefficients);
-	updateCoefficients(rightChain.get<ChainPositions::HighShelf>().coefficients, highShelfCoefficients);
+	return parameterEvents.push({ sampleOffset, parameterIndex, newValue });
 }
 
-void SimpleEQAudioProcessor::updateFilters()
+void SimpleEQAudioProcessor::setAutomationGranularity(int numSamples)
 {
-	auto chainSettings = getChainSettings(apvts);
-
-	updateHighPassFilters(chainSettings);
-	updateLowShelfFilters(chainSettings);
-	updatePeakFilter(chainSettings, 0);
-	updatePeakFilter(chainSettings, 1);
-	updatePeakFilter(chainSettings, 2);
-	updateHighShelfFilters(chainSettings);
-	updateLowPassFilters(chainSettings);
+	automationGranularity = juce::jmax(1, numSamples);
 }
 
-juce::AudioProcessorValueTreeState::ParameterLayout SimpleEQAudioProcessor::createParameterLayout()
+StereoBands SimpleEQAudioProcessor::applyParameterEvent(const ParameterEvent& event, StereoSettings& settings) const
 {
-	juce::AudioProcessorValueTreeState::ParameterLayout layout;
+	const auto& index = parameterTargets[(size_t)event.parameterIndex];
+	const auto& target = parameterTargetTable[index.target];
+	const auto linked = currentStereoMode == StereoMode::StereoMode_Linked;
 
-	// HighPass Freq
-	layout.add(std::make_unique < juce::AudioParameterFloat >(
-		"HighPass Freq",
-		"HighPass Freq",
-		juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
-		20.f));
+	// The second set is ignored while linked
+	if (index.chain == 1 && linked)
+		return {};
 
-	// LowPass Freq
-	layout.add(std::make_unique < juce::AudioParameterFloat >(
-		"LowPass Freq",
-		"LowPass Freq",
-		juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
-		20000.f));
+	StereoBands bands{};
 
-	// LowShelf Freq
-	layout.add(std::make_unique < juce::AudioParameterFloat >(
-		"LowShelf Freq",
-		"LowShelf Freq",
-		juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
-		200.f));
+	if (index.chain != 1)
+	{
+		target.apply(settings[0], event.value);
+		bands[0] = target.bands;
+	}
 
-	// LowShelf Gain
-	layout.add(std::make_unique < juce::AudioParameterFloat >(
-		"LowShelf Gain",
-		"LowShelf Gain",
-		juce::NormalisableRange<float>(-24.f, 24.f, 0.2f, 1.f),
-		0.0f));
+	if (index.chain != 0 || linked)
+	{
+		target.apply(settings[1], event.value);
+		bands[1] = target.bands;
+	}
 
-	// LowShelf Q
-	layout.add(std::make_unique < juce::AudioParameterFloat >(
-		"LowShelf Q",
-		"LowShelf Q",
-		juce::NormalisableRange<float>(0.1f, 5.f, 0.05f, 0.5f),
-		1.f));
+	return bands;
+}
 
-	// Peak 1 Freq
-	layout.add(std::make_unique < juce::AudioParameterFloat >(
-		"Peak 1 Freq",
-		"Peak 1 Freq",
-		juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
-		250.f));
+namespace
+{
+	// In place, scaled so that encoding then decoding is the identity
+	void encodeMidSide(float* left, float* right, size_t numSamples)
+	{
+		for (size_t i = 0; i < numSamples; ++i)
+		{
+			const auto mid = 0.5f * (left[i] + right[i]);
+			const auto side = 0.5f * (left[i] - right[i]);
+			left[i] = mid;
+			right[i] = side;
+		}
+	}
 
-	// Peak 1 Gain
-	layout.add(std::make_unique < juce::AudioParameterFloat >(
-		"Peak 1 Gain",
-		"Peak 1 Gain",
-		juce::NormalisableRange<float>(-24.f, 24.f, 0.2f, 1.f),
-		0.0f));
+	void decodeMidSide(float* mid, float* side, size_t numSamples)
+	{
+		for (size_t i = 0; i < numSamples; ++i)
+		{
+			const auto left = mid[i] + side[i];
+			const auto right = mid[i] - side[i];
+			mid[i] = left;
+			side[i] = right;
+		}
+	}
+}
 
-	// Peak 1 Q
-	layout.add(std::make_unique < juce::AudioParameterFloat >(
-		"Peak 1 Q",
-		"Peak 1 Q",
-		juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 0.5f),
-		1.f));
+void SimpleEQAudioProcessor::processSubBlock(juce::dsp::AudioBlock<float>& block)
+{
+	auto* left = block.getChannelPointer(0);
+	auto* right = block.getChannelPointer(1);
+	const auto numSamples = block.getNumSamples();
 
-	// Peak 2 Freq
-	layout.add(std::make_unique < juce::AudioParameterFloat >(
-		"Peak 2 Freq",
-		"Peak 2 Freq",
-		juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
-		720.f));
+	// The sub-block is still in cache when the chains run over it
+	const auto midSide = currentStereoMode == StereoMode::StereoMode_MidSide;
 
-	// Peak 2 Gain
-	layout.add(std::make_unique < juce::AudioParameterFloat >(
-		"Peak 2 Gain",
-		"Peak 2 Gain",
-		juce::NormalisableRange<float>(-24.f, 24.f, 0.2f, 1.f),
-		0.0f));
+	if (midSide)
+		encodeMidSide(left, right, numSamples);
 
-	// Peak 2 Q
-	layout.add(std::make_unique < juce::AudioParameterFloat >(
-		"Peak 2 Q",
-		"Peak 2 Q",
-		juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 0.5f),
-		1.f));
+	if (! dynamicsActive)
+	{
+		processChains(block);
+	}
+	else
+	{
+		// Detect each slice first, then filter it with the gains it asked for
+		for (size_t position = 0; position < numSamples; position += (size_t)dynamicsControlInterval)
+		{
+			const auto length = juce::jmin((size_t)dynamicsControlInterval, numSamples - position);
+
+			detectors[0].process(left + position, length);
+			detectors[1].process(right + position, length);
+			updateGainReduction();
+
+			auto slice = block.getSubBlock(position, length);
+			processChains(slice);
+		}
+	}
 
-	// Peak 3 Freq
-	layout.add(std::make_unique < juce::AudioParameterFloat >(
-		"Peak 3 Freq",
-		"Peak 3 Freq",
-		juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
-		2000.f));
+	if (midSide)
+		decodeMidSide(left, right, numSamples);
+}
 
-	// Peak 3 Gain
-	layout.add(std::make_unique < juce::AudioParameterFloat >(
-		"Peak 3 Gain",
-		"Peak 3 Gain",
-		juce::NormalisableRange<float>(-24.f, 24.f, 0.2f, 1.f),
-		0.0f));
+namespace
+{
+	template <typename ChainType>
+	void processStereo(juce::dsp::AudioBlock<float>& block, ChainType& leftChain, ChainType& rightChain)
+	{
+		auto leftBlock = block.getSingleChannelBlock(0);
+		auto rightBlock = block.getSingleChannelBlock(1);
 
-	// Peak 3 Q
-	layout.add(std::make_unique < juce::AudioParameterFloat >(
-		"Peak 3 Q",
-		"Peak 3 Q",
-		juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 0.5f),
-		1.f));
+		juce::dsp::ProcessContextReplacing<float> leftContext(leftBlock);
+		juce::dsp::ProcessContextReplacing<float> rightContext(rightBlock);
 
-	// HighShelf Freq
-	layout.add(std::make_unique < juce::AudioParameterFloat >(
-		"HighShelf Freq",
-		"HighShelf Freq",
-		juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
-		2000.f));
+		leftChain.process(leftContext);
+		rightChain.process(rightContext);
+	}
+}
 
-	// HighShelf Gain
-	layout.add(std::make_unique < juce::AudioParameterFloat >(
-		"HighShelf Gain",
-		"HighShelf Gain",
-		juce::NormalisableRange<float>(-24.f, 24.f, 0.2f, 1.f),
-		0.0f));
+void SimpleEQAudioProcessor::processChains(juce::dsp::AudioBlock<float>& block)
+{
+	const auto biquad = currentTopology == Topology::Topology_Biquad;
 
-	// HighShelf Q
-	layout.add(std::make_unique < juce::AudioParameterFloat >(
-		"HighShelf Q",
-		"HighShelf Q",
-		juce::NormalisableRange<float>(0.1f, 5.f, 0.05f, 0.5f),
-		1.f));
+	if (activeOversampler != nullptr && biquad)
+		updateOversampledChains();
+
+	if (! biquad)
+		processStereo(block, leftSvfChain, rightSvfChain);
+	else if (oversampledBands != allBands)
+		processStereo(block, leftChain, rightChain);
+
+	if (activeOversampler == nullptr)
+		return;
 
-	// LowPass/HighPass Options
-	juce::StringArray stringArray;
-	for (int i = 0; i < 4; i++)
+	// The stages are linear and time invariant, so running the oversampled ones
+	// last gives the same response as the chain order. The resampler runs even
+	// with no band above the threshold, so the latency never changes under the host.
+	// Its buffers only hold what initProcessing was given, longer host blocks go in pieces
+	for (size_t position = 0; position < block.getNumSamples(); position += (size_t)oversamplingBlockSize)
 	{
-		juce::String str;
-		str << (12 + i * 12);
-		str << " db/Oct";
-		stringArray.add(str);
+		auto chunk = block.getSubBlock(position, juce::jmin((size_t)oversamplingBlockSize, block.getNumSamples() - position));
+		auto oversampledBlock = activeOversampler->processSamplesUp(chunk);
+
+		if (biquad && oversampledBands != 0)
+			processStereo(oversampledBlock, leftOversampledChain, rightOversampledChain);
+
+		activeOversampler->processSamplesDown(chunk);
 	}
+}
 
-	// HighPass Slope
-	layout.add(std::make_unique < juce::AudioParameterChoice >(
-		"HighPass Slope",
-		"HighPass Slope",
-		stringArray,
-		0));
+void SimpleEQAudioProcessor::resetChains()
+{
+	leftChain.reset();
+	rightChain.reset();
+	leftSvfChain.reset();
+	rightSvfChain.reset();
+	leftOversampledChain.reset();
+	rightOversampledChain.reset();
+	crossover->reset();
+
+	if (activeOversampler != nullptr)
+		activeOversampler->reset();
+
+	// The designed gain reductions stay, the next detection pass releases them
+	for (auto& detector : detectors)
+		detector.reset();
+}
 
-	// LowPass Slope
-	layout.add(std::make_unique < juce::AudioParameterChoice >(
-		"LowPass Slope",
-		"LowPass Slope",
-		stringArray,
-		0));
+//==============================================================================
+bool SimpleEQAudioProcessor::hasEditor() const
+{
+	return true; // (change this to false if you choose to not supply an editor)
+}
+
+juce::AudioProcessorEditor* SimpleEQAudioProcessor::createEditor()
+{
+	return new SimpleEQAudioProcessorEditor(*this);
+	//return new juce::GenericAudioProcessorEditor(*this);
+}
+
+//==============================================================================
+void SimpleEQAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
+{
+	// You should use this method to store your parameters in the memory block.
+	// You could do that either as raw data, or use the XML or ValueTree classes
+	// as intermediaries to make it easy to save and load complex data.
+
+	// Fixed-layout binary, far quicker to restore than the ValueTree
+	writeBinaryState(getParameters(), destData);
+}
+
+void SimpleEQAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
+{
+	// You should use this method to restore your parameters from this memory block,
+	// whose contents will have been created by the getStateInformation() call.
+	// processBlock picks up the changed bands on its next call.
+	if (readBinaryState(data, sizeInBytes, getParameters()))
+		return;
+
+	// Sessions saved before the binary format hold the apvts ValueTree
+	auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
+	if (tree.isValid() )
+	{
+		apvts.replaceState(tree);
+	}
+}
+
+bool SimpleEQAudioProcessor::loadPreset(const PresetBank& bank, int index)
+{
+	const auto* data = bank.getStateData(index);
+
+	if (data == nullptr)
+		return false;
+
+	setStateInformation(data, bank.getStateSize(index));
+	return true;
+}
+
+bool SimpleEQAudioProcessor::startMatchFit()
+{
+	std::vector<float> reference, current;
+
+	if (matchAnalyzer.getAverageSpectrum(SpectrumAnalyzer::Slot_Reference, reference) == 0
+		|| matchAnalyzer.getAverageSpectrum(SpectrumAnalyzer::Slot_Current, current) == 0)
+		return false;
+
+	// Slopes and everything else the fit doesn't touch stay as they are
+	matchFitter->start(reference, current, SpectrumAnalyzer::fftSize, matchAnalyzer.getSampleRate(), getChainSettings(apvts));
+	return true;
+}
+
+bool SimpleEQAudioProcessor::isMatchFitRunning() const
+{
+	return matchFitter->isFitting();
+}
+
+bool SimpleEQAudioProcessor::applyMatchFit()
+{
+	const auto result = matchFitter->takeResult();
+
+	if (! result.has_value())
+		return false;
+
+	const auto& s = result->settings;
+
+	const std::pair<const char*, float> values[] =
+	{
+		{ "HighPass Freq", s.highPassFreq },
+		{ "LowPass Freq", s.lowPassFreq },
+		{ "LowShelf Freq", s.lowShelfFreq },
+		{ "LowShelf Gain", s.lowShelfGainInDecibels },
+		{ "LowShelf Q", s.lowShelfQ },
+		{ "HighShelf Freq", s.highShelfFreq },
+		{ "HighShelf Gain", s.highShelfGainInDecibels },
+		{ "HighShelf Q", s.highShelfQ },
+		{ "Peak 1 Freq", s.peakFreq[0] },
+		{ "Peak 1 Gain", s.peakGainInDecibels[0] },
+		{ "Peak 1 Q", s.peakQ[0] },
+		{ "Peak 2 Freq", s.peakFreq[1] },
+		{ "Peak 2 Gain", s.peakGainInDecibels[1] },
+		{ "Peak 2 Q", s.peakQ[1] },
+		{ "Peak 3 Freq", s.peakFreq[2] },
+		{ "Peak 3 Gain", s.peakGainInDecibels[2] },
+		{ "Peak 3 Q", s.peakQ[2] },
+	};
+
+	// One gesture per parameter, so hosts record the change as automation
+	for (const auto& [parameterID, value] : values)
+	{
+		auto* parameter = apvts.getParameter(parameterID);
+		parameter->beginChangeGesture();
+		parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+		parameter->endChangeGesture();
+	}
+
+	return true;
+}
+
+ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts)
+{
+	ChainSettings settings;
+
+	// HighPass
+	settings.highPassFreq = apvts.getRawParameterValue("HighPass Freq")->load();
+	settings.highPassSlope = static_cast<Slope>(apvts.getRawParameterValue("HighPass Slope")->load());
+	// LowPass
+	settings.lowPassFreq = apvts.getRawParameterValue("LowPass Freq")->load();
+	settings.lowPassSlope = static_cast<Slope>(apvts.getRawParameterValue("LowPass Slope")->load());
+	// LowShelf
+	settings.lowShelfFreq = apvts.getRawParameterValue("LowShelf Freq")->load();
+	settings.lowShelfGainInDecibels = apvts.getRawParameterValue("LowShelf Gain")->load();
+	settings.lowShelfQ = apvts.getRawParameterValue("LowShelf Q")->load();
+	// HighShelf
+	settings.highShelfFreq = apvts.getRawParameterValue("HighShelf Freq")->load();
+	settings.highShelfGainInDecibels = apvts.getRawParameterValue("HighShelf Gain")->load();
+	settings.highShelfQ = apvts.getRawParameterValue("HighShelf Q")->load();
+	// Peak 1
+	settings.peakFreq[0] = apvts.getRawParameterValue("Peak 1 Freq")->load();
+	settings.peakGainInDecibels[0] = apvts.getRawParameterValue("Peak 1 Gain")->load();
+	settings.peakQ[0] = apvts.getRawParameterValue("Peak 1 Q")->load();
+	// Peak 2
+	settings.peakFreq[1] = apvts.getRawParameterValue("Peak 2 Freq")->load();
+	settings.peakGainInDecibels[1] = apvts.getRawParameterValue("Peak 2 Gain")->load();
+	settings.peakQ[1] = apvts.getRawParameterValue("Peak 2 Q")->load();
+	// Peak 3
+	settings.peakFreq[2] = apvts.getRawParameterValue("Peak 3 Freq")->load();
+	settings.peakGainInDecibels[2] = apvts.getRawParameterValue("Peak 3 Gain")->load();
+	settings.peakQ[2] = apvts.getRawParameterValue("Peak 3 Q")->load();
+	// Topology
+	settings.topology = static_cast<Topology>(apvts.getRawParameterValue("Filter Topology")->load());
+	// Dynamics
+	for (int i = 0; i < numDynamicBands; ++i)
+	{
+		const juce::String name{ dynamicBandNames[i] };
+		auto& dynamics = settings.dynamics[i];
+
+		dynamics.enabled = apvts.getRawParameterValue(name + " Dynamic")->load() > 0.5f;
+		dynamics.thresholdInDecibels = apvts.getRawParameterValue(name + " Threshold")->load();
+		dynamics.ratio = apvts.getRawParameterValue(name + " Ratio")->load();
+		dynamics.attackInMilliseconds = apvts.getRawParameterValue(name + " Attack")->load();
+		dynamics.releaseInMilliseconds = apvts.getRawParameterValue(name + " Release")->load();
+	}
+
+	return settings;
+}
+
+std::optional<juce::uint32> setChainParameter(ChainSettings& chainSettings, const juce::String& parameterID, float value)
+{
+	for (const auto& target : parameterTargetTable)
+	{
+		if (parameterID == target.parameterID)
+		{
+			target.apply(chainSettings, value);
+			return target.bands;
+		}
+	}
+
+	return std::nullopt;
+}
+
+void ChainParameters::attach(juce::AudioProcessorValueTreeState& apvts, const juce::String& suffix)
+{
+	values.clear();
+
+	for (const auto& target : parameterTargetTable)
+	{
+		auto* value = apvts.getRawParameterValue(target.parameterID + suffix);
+
+		// Shared parameters such as the topology only exist once
+		if (value == nullptr)
+			value = apvts.getRawParameterValue(target.parameterID);
+
+		jassert(value != nullptr);
+		values.push_back(value);
+	}
+}
+
+ChainSettings ChainParameters::load() const
+{
+	ChainSettings settings;
+
+	for (size_t i = 0; i < values.size(); ++i)
+		parameterTargetTable[i].apply(settings, values[i]->load());
+
+	return settings;
+}
+
+namespace
+{
+	// The settings with each dynamic band's gain pulled down by its reduction
+	ChainSettings withGainReduction(const ChainSettings& chainSettings, const float* reductionsInDecibels)
+	{
+		auto settings = chainSettings;
+
+		settings.lowShelfGainInDecibels -= reductionsInDecibels[0];
+		for (int i = 0; i < 3; ++i)
+			settings.peakGainInDecibels[i] -= reductionsInDecibels[1 + i];
+		settings.highShelfGainInDecibels -= reductionsInDecibels[4];
+
+		return settings;
+	}
+
+	// Whether the detector of a dynamic band needs a redesign
+	bool detectorChanged(const ChainSettings& a, const ChainSettings& b, int dynamicBand)
+	{
+		if (dynamicBand == 0)
+			return a.lowShelfFreq != b.lowShelfFreq;
+
+		if (dynamicBand == numDynamicBands - 1)
+			return a.highShelfFreq != b.highShelfFreq;
+
+		const auto peak = dynamicBand - 1;
+		return a.peakFreq[peak] != b.peakFreq[peak] || a.peakQ[peak] != b.peakQ[peak];
+	}
+
+	// Shelves listen below or above their corner, peaks to their own band
+	CoefficientArray makeDetectorCoefficients(const ChainSettings& chainSettings, int dynamicBand, double sampleRate)
+	{
+		using ArrayCoefficients = juce::dsp::IIR::ArrayCoefficients<float>;
+
+		if (dynamicBand == 0)
+			return ArrayCoefficients::makeLowPass(sampleRate, chainSettings.lowShelfFreq);
+
+		if (dynamicBand == numDynamicBands - 1)
+			return ArrayCoefficients::makeHighPass(sampleRate, chainSettings.highShelfFreq);
+
+		const auto peak = dynamicBand - 1;
+		return ArrayCoefficients::makeBandPass(sampleRate, chainSettings.peakFreq[peak], chainSettings.peakQ[peak]);
+	}
+
+	float interpolateFrequency(float a, float b, float proportion)
+	{
+		if (a <= 0.f || b <= 0.f)
+			return b;
+
+		return a * std::pow(b / a, proportion);
+	}
+}
+
+ChainSettings interpolateChainSettings(const ChainSettings& a, const ChainSettings& b, float proportion)
+{
+	// Land exactly on b, otherwise rounding would leave bands "changed" forever
+	if (proportion >= 1.f)
+		return b;
+
+	auto settings = b;
+
+	for (int i = 0; i < 3; ++i)
+	{
+		settings.peakFreq[i] = interpolateFrequency(a.peakFreq[i], b.peakFreq[i], proportion);
+		settings.peakGainInDecibels[i] = juce::jmap(proportion, a.peakGainInDecibels[i], b.peakGainInDecibels[i]);
+		settings.peakQ[i] = juce::jmap(proportion, a.peakQ[i], b.peakQ[i]);
+	}
+
+	settings.highPassFreq = interpolateFrequency(a.highPassFreq, b.highPassFreq, proportion);
+	settings.lowPassFreq = interpolateFrequency(a.lowPassFreq, b.lowPassFreq, proportion);
+
+	settings.lowShelfFreq = interpolateFrequency(a.lowShelfFreq, b.lowShelfFreq, proportion);
+	settings.lowShelfGainInDecibels = juce::jmap(proportion, a.lowShelfGainInDecibels, b.lowShelfGainInDecibels);
+	settings.lowShelfQ = juce::jmap(proportion, a.lowShelfQ, b.lowShelfQ);
+
+	settings.highShelfFreq = interpolateFrequency(a.highShelfFreq, b.highShelfFreq, proportion);
+	settings.highShelfGainInDecibels = juce::jmap(proportion, a.highShelfGainInDecibels, b.highShelfGainInDecibels);
+	settings.highShelfQ = juce::jmap(proportion, a.highShelfQ, b.highShelfQ);
+
+	return settings;
+}
+
+juce::uint32 getChangedBands(const ChainSettings& a, const ChainSettings& b)
+{
+	if (a.topology != b.topology)
+		return allBands;
+
+	juce::uint32 bands = 0;
+
+	if (a.highPassFreq != b.highPassFreq || a.highPassSlope != b.highPassSlope)
+		bands |= getBandMask(ChainPositions::HighPass);
+
+	if (a.lowShelfFreq != b.lowShelfFreq || a.lowShelfGainInDecibels != b.lowShelfGainInDecibels || a.lowShelfQ != b.lowShelfQ)
+		bands |= getBandMask(ChainPositions::LowShelf);
+
+	for (int i = 0; i < 3; ++i)
+		if (a.peakFreq[i] != b.peakFreq[i] || a.peakGainInDecibels[i] != b.peakGainInDecibels[i] || a.peakQ[i] != b.peakQ[i])
+			bands |= getBandMask(ChainPositions::Peak1 + i);
+
+	if (a.highShelfFreq != b.highShelfFreq || a.highShelfGainInDecibels != b.highShelfGainInDecibels || a.highShelfQ != b.highShelfQ)
+		bands |= getBandMask(ChainPositions::HighShelf);
+
+	if (a.lowPassFreq != b.lowPassFreq || a.lowPassSlope != b.lowPassSlope)
+		bands |= getBandMask(ChainPositions::LowPass);
+
+	return bands;
+}
+
+// Update Coefficients
+void updateCoefficients(Coefficients& old, const Coefficients& replacements)
+{
+	*old = *replacements;
+}
+
+void updateCoefficients(Coefficients& old, const CoefficientArray& replacements)
+{
+	*old = replacements;
+}
+
+CoefficientArray makePeakCoefficients(const ChainSettings& chainSettings, double sampleRate, int filterNr)
+{
+	return juce::dsp::IIR::ArrayCoefficients<float>::makePeakFilter(
+		sampleRate,
+		chainSettings.peakFreq[filterNr],
+		chainSettings.peakQ[filterNr],
+		juce::Decibels::decibelsToGain(chainSettings.peakGainInDecibels[filterNr]));
+}
+
+Coefficients makePeakFilter(const ChainSettings& chainSettings, double sampleRate, int filterNr)
+{
+	return new juce::dsp::IIR::Coefficients<float>(makePeakCoefficients(chainSettings, sampleRate, filterNr));
+}
+
+// Same sections as FilterDesign's HighOrderButterworthMethod, without the allocations
+CutCoefficientArrays makeHighPassCoefficients(const ChainSettings& chainSettings, double sampleRate)
+{
+	CutCoefficientArrays sections{};
+	const auto order = 2 * (chainSettings.highPassSlope + 1);
+
+	for (int i = 0; i < order / 2; ++i)
+		sections[(size_t)i] = juce::dsp::IIR::ArrayCoefficients<float>::makeHighPass(
+			sampleRate,
+			chainSettings.highPassFreq,
+			getButterworthQ(order, i));
+
+	return sections;
+}
+
+CutCoefficientArrays makeLowPassCoefficients(const ChainSettings& chainSettings, double sampleRate)
+{
+	CutCoefficientArrays sections{};
+	const auto order = 2 * (chainSettings.lowPassSlope + 1);
+
+	for (int i = 0; i < order / 2; ++i)
+		sections[(size_t)i] = juce::dsp::IIR::ArrayCoefficients<float>::makeLowPass(
+			sampleRate,
+			chainSettings.lowPassFreq,
+			getButterworthQ(order, i));
+
+	return sections;
+}
+
+CoefficientArray makePeakCoefficients(const ChainSettings& chainSettings, const CoefficientTables& tables, int filterNr)
+{
+	return tables.makePeak(chainSettings.peakFreq[filterNr], chainSettings.peakQ[filterNr], chainSettings.peakGainInDecibels[filterNr]);
+}
+
+CutCoefficientArrays makeHighPassCoefficients(const ChainSettings& chainSettings, const CoefficientTables& tables)
+{
+	CutCoefficientArrays sections{};
+	const auto order = 2 * (chainSettings.highPassSlope + 1);
+
+	for (int i = 0; i < order / 2; ++i)
+		sections[(size_t)i] = tables.makeHighPass(chainSettings.highPassFreq, getButterworthQ(order, i));
+
+	return sections;
+}
+
+CutCoefficientArrays makeLowPassCoefficients(const ChainSettings& chainSettings, const CoefficientTables& tables)
+{
+	CutCoefficientArrays sections{};
+	const auto order = 2 * (chainSettings.lowPassSlope + 1);
+
+	for (int i = 0; i < order / 2; ++i)
+		sections[(size_t)i] = tables.makeLowPass(chainSettings.lowPassFreq, getButterworthQ(order, i));
+
+	return sections;
+}
+
+CoefficientArray makeLowShelfCoefficients(const ChainSettings& chainSettings, const CoefficientTables& tables)
+{
+	return tables.makeLowShelf(chainSettings.lowShelfFreq, chainSettings.lowShelfQ, chainSettings.lowShelfGainInDecibels);
+}
+
+CoefficientArray makeHighShelfCoefficients(const ChainSettings& chainSettings, const CoefficientTables& tables)
+{
+	return tables.makeHighShelf(chainSettings.highShelfFreq, chainSettings.highShelfQ, chainSettings.highShelfGainInDecibels);
+}
+
+// Peak Filters
+void SimpleEQAudioProcessor::updatePeakFilter(const ChainSettings& chainSettings, int filterNr, juce::uint32 channels)
+{
+	auto peakCoefficients = makePeakCoefficients(chainSettings, *coefficientTables, filterNr);
+
+	forEachChain(channels, [&](MonoChain& chain)
+	{
+		if (filterNr == 0)
+			updateCoefficients(chain.get<ChainPositions::Peak1>().coefficients, peakCoefficients);
+		else if (filterNr == 1)
+			updateCoefficients(chain.get<ChainPositions::Peak2>().coefficients, peakCoefficients);
+		else if (filterNr == 2)
+			updateCoefficients(chain.get<ChainPositions::Peak3>().coefficients, peakCoefficients);
+	});
+}
+
+// High Pass Filter
+void SimpleEQAudioProcessor::updateHighPassFilters(const ChainSettings& chainSettings, juce::uint32 channels)
+{
+	auto highPassCoefficients = makeHighPassCoefficients(chainSettings, *coefficientTables);
+
+	forEachChain(channels, [&](MonoChain& chain)
+	{
+		updateCutFilter(chain.get<ChainPositions::HighPass>(), highPassCoefficients, chainSettings.highPassSlope);
+	});
+}
+
+// Low Pass Filter
+void SimpleEQAudioProcessor::updateLowPassFilters(const ChainSettings& chainSettings, juce::uint32 channels)
+{
+	auto lowPassCoefficients = makeLowPassCoefficients(chainSettings, *coefficientTables);
+
+	forEachChain(channels, [&](MonoChain& chain)
+	{
+		updateCutFilter(chain.get<ChainPositions::LowPass>(), lowPassCoefficients, chainSettings.lowPassSlope);
+	});
+}
+
+CoefficientArray makeLowShelfCoefficients(const ChainSettings& chainSettings, double sampleRate)
+{
+	return juce::dsp::IIR::ArrayCoefficients<float>::makeLowShelf(
+		sampleRate,
+		chainSettings.lowShelfFreq,
+		chainSettings.lowShelfQ,
+		juce::Decibels::decibelsToGain(chainSettings.lowShelfGainInDecibels));
+}
+
+Coefficients makeLowShelfFilter(const ChainSettings& chainSettings, double sampleRate)
+{
+	return new juce::dsp::IIR::Coefficients<float>(makeLowShelfCoefficients(chainSettings, sampleRate));
+}
+
+// Low Shelf Filter
+void SimpleEQAudioProcessor::updateLowShelfFilters(const ChainSettings& chainSettings, juce::uint32 channels)
+{
+	auto lowShelfCoefficients = makeLowShelfCoefficients(chainSettings, *coefficientTables);
+
+	forEachChain(channels, [&](MonoChain& chain)
+	{
+		updateCoefficients(chain.get<ChainPositions::LowShelf>().coefficients, lowShelfCoefficients);
+	});
+}
+
+CoefficientArray makeHighShelfCoefficients(const ChainSettings& chainSettings, double sampleRate)
+{
+	return juce::dsp::IIR::ArrayCoefficients<float>::makeHighShelf(
+		sampleRate,
+		chainSettings.highShelfFreq,
+		chainSettings.highShelfQ,
+		juce::Decibels::decibelsToGain(chainSettings.highShelfGainInDecibels));
+}
+
+Coefficients makeHighShelfFilter(const ChainSettings& chainSettings, double sampleRate)
+{
+	return new juce::dsp::IIR::Coefficients<float>(makeHighShelfCoefficients(chainSettings, sampleRate));
+}
+
+// High Shelf
+void SimpleEQAudioProcessor::updateHighShelfFilters(const ChainSettings& chainSettings, juce::uint32 channels)
+{
+	auto highShelfCoefficients = makeHighShelfCoefficients(chainSettings, *coefficientTables);
+
+	forEachChain(channels, [&](MonoChain& chain)
+	{
+		updateCoefficients(chain.get<ChainPositions::HighShelf>().coefficients, highShelfCoefficients);
+	});
+}
+
+// State Variable Filters
+void SimpleEQAudioProcessor::updateSvfFilters(const ChainSettings& chainSettings, juce::uint32 bands, juce::uint32 channels)
+{
+	for (auto* chain : { &leftSvfChain, &rightSvfChain })
+	{
+		if (! (channels & (chain == &leftSvfChain ? Channel_Left : Channel_Right)))
+			continue;
+
+		if (bands & getBandMask(ChainPositions::HighPass))
+			updateSvfCutFilter(chain->get<ChainPositions::HighPass>(), SvfType::HighPass, chainSettings.highPassFreq, chainSettings.highPassSlope);
+		if (bands & getBandMask(ChainPositions::LowShelf))
+			chain->get<ChainPositions::LowShelf>().setParameters(SvfType::LowShelf, chainSettings.lowShelfFreq, chainSettings.lowShelfQ, chainSettings.lowShelfGainInDecibels);
+		if (bands & getBandMask(ChainPositions::Peak1))
+			chain->get<ChainPositions::Peak1>().setParameters(SvfType::Peak, chainSettings.peakFreq[0], chainSettings.peakQ[0], chainSettings.peakGainInDecibels[0]);
+		if (bands & getBandMask(ChainPositions::Peak2))
+			chain->get<ChainPositions::Peak2>().setParameters(SvfType::Peak, chainSettings.peakFreq[1], chainSettings.peakQ[1], chainSettings.peakGainInDecibels[1]);
+		if (bands & getBandMask(ChainPositions::Peak3))
+			chain->get<ChainPositions::Peak3>().setParameters(SvfType::Peak, chainSettings.peakFreq[2], chainSettings.peakQ[2], chainSettings.peakGainInDecibels[2]);
+		if (bands & getBandMask(ChainPositions::HighShelf))
+			chain->get<ChainPositions::HighShelf>().setParameters(SvfType::HighShelf, chainSettings.highShelfFreq, chainSettings.highShelfQ, chainSettings.highShelfGainInDecibels);
+		if (bands & getBandMask(ChainPositions::LowPass))
+			updateSvfCutFilter(chain->get<ChainPositions::LowPass>(), SvfType::LowPass, chainSettings.lowPassFreq, chainSettings.lowPassSlope);
+	}
+}
+
+void SimpleEQAudioProcessor::designBands(const ChainSettings& chainSettings, juce::uint32 bands, juce::uint32 channels)
+{
+	if (currentTopology == Topology::Topology_Svf)
+	{
+		// Only a few scalars change here, cheap enough to do at every split
+		updateSvfFilters(chainSettings, bands, channels);
+	}
+	else
+	{
+		if (bands & getBandMask(ChainPositions::HighPass))
+			updateHighPassFilters(chainSettings, channels);
+		if (bands & getBandMask(ChainPositions::LowShelf))
+			updateLowShelfFilters(chainSettings, channels);
+		if (bands & getBandMask(ChainPositions::Peak1))
+			updatePeakFilter(chainSettings, 0, channels);
+		if (bands & getBandMask(ChainPositions::Peak2))
+			updatePeakFilter(chainSettings, 1, channels);
+		if (bands & getBandMask(ChainPositions::Peak3))
+			updatePeakFilter(chainSettings, 2, channels);
+		if (bands & getBandMask(ChainPositions::HighShelf))
+			updateHighShelfFilters(chainSettings, channels);
+		if (bands & getBandMask(ChainPositions::LowPass))
+			updateLowPassFilters(chainSettings, channels);
+	}
+}
+
+void SimpleEQAudioProcessor::applySettings(const ChainSettings& chainSettings, juce::uint32 bands, juce::uint32 channels)
+{
+	// Both chains always share a topology, see applyStereoSettings
+	const auto topologyChanged = chainSettings.topology != currentTopology;
+	currentTopology = chainSettings.topology;
+
+	if (topologyChanged)
+		bands = allBands;
+
+	// Linked chains share one design, and so one set of gain reductions
+	if (channels == Channel_Both)
+		std::copy(std::begin(gainReduction[0]), std::end(gainReduction[0]), std::begin(gainReduction[1]));
+
+	designBands(withGainReduction(chainSettings, gainReduction[channels == Channel_Right ? 1 : 0]), bands, channels);
+
+	// The inactive topology keeps stale state, so start clean when switching
+	if (topologyChanged)
+		resetChains();
+
+	if (channels & Channel_Left)
+		appliedSettings[0] = chainSettings;
+	if (channels & Channel_Right)
+		appliedSettings[1] = chainSettings;
+}
+
+void SimpleEQAudioProcessor::applyStereoSettings(const StereoSettings& settings, StereoBands bands)
+{
+	// The topology is shared, switching it redesigns both chains
+	if (settings[0].topology != currentTopology)
+		bands = { allBands, allBands };
+
+	if (currentStereoMode == StereoMode::StereoMode_Linked)
+	{
+		// Design once, copy the coefficients into both chains
+		if ((bands[0] | bands[1]) != 0)
+			applySettings(settings[0], bands[0] | bands[1], Channel_Both);
+
+		return;
+	}
+
+	if (bands[0] != 0)
+		applySettings(settings[0], bands[0], Channel_Left);
+	if (bands[1] != 0)
+		applySettings(settings[1], bands[1], Channel_Right);
+}
+
+StereoBands SimpleEQAudioProcessor::getChangedStereoBands(const StereoSettings& settings) const
+{
+	return { getChangedBands(appliedSettings[0], settings[0]),
+			 getChangedBands(appliedSettings[1], settings[1]) };
+}
+
+StereoSettings SimpleEQAudioProcessor::getTargetSettings() const
+{
+	const auto first = chainParameters[0].load();
+
+	if (currentStereoMode == StereoMode::StereoMode_Linked)
+		return { first, first };
+
+	// The topology parameter is shared, so both loads agree on it
+	return { first, chainParameters[1].load() };
+}
+
+void SimpleEQAudioProcessor::updateDetectors(const StereoSettings& settings)
+{
+	dynamicsActive = false;
+
+	for (size_t chain = 0; chain < 2; ++chain)
+	{
+		for (int band = 0; band < numDynamicBands; ++band)
+		{
+			const auto& dynamics = settings[chain].dynamics[band];
+			const auto& previous = detectorSettings[chain].dynamics[band];
+
+			// The detector follows the band's frequency and Q, not its gain
+			if (! detectorsValid || dynamics != previous || detectorChanged(settings[chain], detectorSettings[chain], band))
+			{
+				if (dynamics.enabled)
+					detectors[chain].setLane((size_t)band, makeDetectorCoefficients(settings[chain], band, getSampleRate()), dynamics);
+				else
+					detectors[chain].clearLane((size_t)band);
+			}
+
+			// Keep going until a disabled band has released its reduction
+			dynamicsActive = dynamicsActive || dynamics.enabled || gainReduction[chain][band] != 0.f;
+		}
+	}
+
+	detectorSettings = settings;
+	detectorsValid = true;
+}
+
+void SimpleEQAudioProcessor::updateGainReduction()
+{
+	const auto linked = currentStereoMode == StereoMode::StereoMode_Linked;
+
+	for (int chain = 0; chain < (linked ? 1 : 2); ++chain)
+	{
+		juce::uint32 bands = 0;
+
+		for (int band = 0; band < numDynamicBands; ++band)
+		{
+			auto envelope = detectors[chain].getEnvelope((size_t)band);
+
+			// Linked chains react to whichever channel is louder
+			if (linked)
+				envelope = juce::jmax(envelope, detectors[1].getEnvelope((size_t)band));
+
+			const auto reduction = getGainReductionInDecibels(detectorSettings[chain].dynamics[band], envelope);
+			auto& applied = gainReduction[chain][band];
+
+			if (std::abs(reduction - applied) > gainReductionHysteresis || (reduction == 0.f && applied != 0.f))
+			{
+				applied = reduction;
+				bands |= getBandMask(getDynamicBandPosition(band));
+			}
+		}
+
+		if (bands == 0)
+			continue;
+
+		if (linked)
+		{
+			std::copy(std::begin(gainReduction[0]), std::end(gainReduction[0]), std::begin(gainReduction[1]));
+			designBands(withGainReduction(appliedSettings[0], gainReduction[0]), bands, Channel_Both);
+		}
+		else
+		{
+			designBands(withGainReduction(appliedSettings[chain], gainReduction[chain]), bands, chain == 0 ? Channel_Left : Channel_Right);
+		}
+	}
+}
+
+namespace
+{
+	// ChainPositions are template arguments of ProcessorChain, these map them at run time
+	void setStageBypassed(MonoChain& chain, int position, bool bypassed)
+	{
+		switch (position)
+		{
+		case ChainPositions::HighPass: chain.setBypassed<ChainPositions::HighPass>(bypassed); break;
+		case ChainPositions::LowShelf: chain.setBypassed<ChainPositions::LowShelf>(bypassed); break;
+		case ChainPositions::Peak1: chain.setBypassed<ChainPositions::Peak1>(bypassed); break;
+		case ChainPositions::Peak2: chain.setBypassed<ChainPositions::Peak2>(bypassed); break;
+		case ChainPositions::Peak3: chain.setBypassed<ChainPositions::Peak3>(bypassed); break;
+		case ChainPositions::HighShelf: chain.setBypassed<ChainPositions::HighShelf>(bypassed); break;
+		case ChainPositions::LowPass: chain.setBypassed<ChainPositions::LowPass>(bypassed); break;
+		default: break;
+		}
+	}
+
+	void resetStage(MonoChain& chain, int position)
+	{
+		switch (position)
+		{
+		case ChainPositions::HighPass: chain.get<ChainPositions::HighPass>().reset(); break;
+		case ChainPositions::LowShelf: chain.get<ChainPositions::LowShelf>().reset(); break;
+		case ChainPositions::Peak1: chain.get<ChainPositions::Peak1>().reset(); break;
+		case ChainPositions::Peak2: chain.get<ChainPositions::Peak2>().reset(); break;
+		case ChainPositions::Peak3: chain.get<ChainPositions::Peak3>().reset(); break;
+		case ChainPositions::HighShelf: chain.get<ChainPositions::HighShelf>().reset(); break;
+		case ChainPositions::LowPass: chain.get<ChainPositions::LowPass>().reset(); break;
+		default: break;
+		}
+	}
+
+	// The frequency a band's cramping depends on: centre for bells and shelves, cutoff for cuts
+	float getCornerFrequency(const ChainSettings& chainSettings, int position)
+	{
+		switch (position)
+		{
+		case ChainPositions::HighPass: return chainSettings.highPassFreq;
+		case ChainPositions::LowShelf: return chainSettings.lowShelfFreq;
+		case ChainPositions::Peak1: return chainSettings.peakFreq[0];
+		case ChainPositions::Peak2: return chainSettings.peakFreq[1];
+		case ChainPositions::Peak3: return chainSettings.peakFreq[2];
+		case ChainPositions::HighShelf: return chainSettings.highShelfFreq;
+		case ChainPositions::LowPass: return chainSettings.lowPassFreq;
+		default: return 0.f;
+		}
+	}
+
+	// Like designBands, but for any chain, at the tables' rate
+	void designChainBands(MonoChain& chain, const ChainSettings& chainSettings, const CoefficientTables& tables, juce::uint32 bands)
+	{
+		if (bands & getBandMask(ChainPositions::HighPass))
+			updateCutFilter(chain.get<ChainPositions::HighPass>(), makeHighPassCoefficients(chainSettings, tables), chainSettings.highPassSlope);
+		if (bands & getBandMask(ChainPositions::LowShelf))
+			updateCoefficients(chain.get<ChainPositions::LowShelf>().coefficients, makeLowShelfCoefficients(chainSettings, tables));
+		if (bands & getBandMask(ChainPositions::Peak1))
+			updateCoefficients(chain.get<ChainPositions::Peak1>().coefficients, makePeakCoefficients(chainSettings, tables, 0));
+		if (bands & getBandMask(ChainPositions::Peak2))
+			updateCoefficients(chain.get<ChainPositions::Peak2>().coefficients, makePeakCoefficients(chainSettings, tables, 1));
+		if (bands & getBandMask(ChainPositions::Peak3))
+			updateCoefficients(chain.get<ChainPositions::Peak3>().coefficients, makePeakCoefficients(chainSettings, tables, 2));
+		if (bands & getBandMask(ChainPositions::HighShelf))
+			updateCoefficients(chain.get<ChainPositions::HighShelf>().coefficients, makeHighShelfCoefficients(chainSettings, tables));
+		if (bands & getBandMask(ChainPositions::LowPass))
+			updateCutFilter(chain.get<ChainPositions::LowPass>(), makeLowPassCoefficients(chainSettings, tables), chainSettings.lowPassSlope);
+	}
+}
+
+bool SimpleEQAudioProcessor::updateOversampling(bool force)
+{
+	const auto mode = static_cast<OversamplingMode>((int)oversamplingParameter->load());
+	const auto filter = (int)oversamplingFilterParameter->load();
+
+	if (! force && mode == currentOversamplingMode && filter == currentOversamplingFilter)
+		return false;
+
+	currentOversamplingMode = mode;
+	currentOversamplingFilter = filter;
+
+	const auto fourTimes = mode == OversamplingMode::Oversampling_4xSelective || mode == OversamplingMode::Oversampling_4xFull;
+	activeOversampler = mode == OversamplingMode::Oversampling_Off ? nullptr : oversamplers[fourTimes ? 1 : 0][filter].get();
+
+	// Every band starts at the host rate again, updateOversampledChains moves them over
+	routeOversampledBands(0);
+	leftOversampledChain.reset();
+	rightOversampledChain.reset();
+	oversampledSettingsValid = false;
+
+	if (activeOversampler != nullptr)
+		activeOversampler->reset();
+
+	oversamplingLatency.store(activeOversampler != nullptr ? juce::roundToInt(activeOversampler->getLatencyInSamples()) : 0);
+
+	// The silence detection has to wait for the delayed output too
+	tailLengthValid = false;
+
+	return true;
+}
+
+void SimpleEQAudioProcessor::routeOversampledBands(juce::uint32 bands)
+{
+	for (int position = ChainPositions::HighPass; position <= ChainPositions::LowPass; ++position)
+	{
+		const auto oversampled = (bands & getBandMask(position)) != 0;
+
+		// A stage that moves chains starts from a cleared state in its new chain
+		if (oversampled != ((oversampledBands & getBandMask(position)) != 0))
+		{
+			resetStage(oversampled ? leftOversampledChain : leftChain, position);
+			resetStage(oversampled ? rightOversampledChain : rightChain, position);
+		}
+
+		for (auto* chain : { &leftChain, &rightChain })
+			setStageBypassed(*chain, position, oversampled);
+		for (auto* chain : { &leftOversampledChain, &rightOversampledChain })
+			setStageBypassed(*chain, position, ! oversampled);
+	}
+
+	// Bands that just moved over were never designed at the higher rate
+	if ((bands & ~oversampledBands) != 0)
+		oversampledSettingsValid = false;
+
+	oversampledBands = bands;
+}
+
+void SimpleEQAudioProcessor::updateOversampledChains()
+{
+	const auto sampleRate = getSampleRate();
+	auto bands = allBands;
+
+	if (currentOversamplingMode == OversamplingMode::Oversampling_2xSelective
+		|| currentOversamplingMode == OversamplingMode::Oversampling_4xSelective)
+	{
+		bands = 0;
+
+		// Both chains share the routing, whichever needs a band oversampled wins
+		for (int position = ChainPositions::HighPass; position <= ChainPositions::LowPass; ++position)
+		{
+			const auto ratio = (oversampledBands & getBandMask(position)) != 0 ? oversamplingLeaveRatio : oversamplingEnterRatio;
+
+			for (const auto& settings : appliedSettings)
+				if (getCornerFrequency(settings, position) > ratio * sampleRate)
+					bands |= getBandMask(position);
+		}
+	}
+
+	if (bands != oversampledBands)
+		routeOversampledBands(bands);
+
+	const auto& tables = *oversampledCoefficientTables[activeOversampler->getOversamplingFactor() == 4 ? 1 : 0];
+
+	for (int chain = 0; chain < 2; ++chain)
+	{
+		const auto settings = withGainReduction(appliedSettings[chain], gainReduction[chain]);
+		const auto changed = oversampledSettingsValid ? getChangedBands(settings, oversampledSettings[chain]) & oversampledBands : oversampledBands;
+
+		if (changed != 0)
+			designChainBands(chain == 0 ? leftOversampledChain : rightOversampledChain, settings, tables, changed);
+
+		oversampledSettings[chain] = settings;
+	}
+
+	oversampledSettingsValid = true;
+}
+
+void SimpleEQAudioProcessor::handleAsyncUpdate()
+{
+	setLatencySamples(oversamplingLatency.load());
+}
+
+void SimpleEQAudioProcessor::updateFilters()
+{
+	currentStereoMode = static_cast<StereoMode>((int)stereoModeParameter->load());
+	applyStereoSettings(getTargetSettings(), { allBands, allBands });
+}
+
+void SimpleEQAudioProcessor::updateTailLength()
+{
+	if (tailLengthValid
+		&& getChangedBands(tailSettings[0], appliedSettings[0]) == 0
+		&& getChangedBands(tailSettings[1], appliedSettings[1]) == 0)
+		return;
+
+	tailSettings = appliedSettings;
+	tailLengthValid = true;
+
+	// The chains run in parallel, so the longer one sets the tail
+	const auto samples = juce::jmax(getTailLengthInSamples(appliedSettings[0], getSampleRate()),
+									getTailLengthInSamples(appliedSettings[1], getSampleRate()))
+		+ crossover->getTailLengthInSamples();
+	tailLengthSamples = (int)std::ceil(samples) + oversamplingLatency.load();
+	tailLengthSeconds.store(samples / getSampleRate());
+}
+
+void SimpleEQAudioProcessor::publishResponse()
+{
+	PublishedResponse response;
+	response.sampleRate = getSampleRate();
+	response.stereoMode = currentStereoMode;
+
+	for (int chain = 0; chain < 2; ++chain)
+	{
+		// The SVF chains realise the same transfer functions as the biquad designs
+		if (currentTopology == Topology::Topology_Svf)
+			response.coefficients[(size_t)chain] = makeChainCoefficients(withGainReduction(appliedSettings[chain], gainReduction[chain]), *coefficientTables);
+		else
+			response.coefficients[(size_t)chain] = getChainCoefficients(chain == 0 ? leftChain : rightChain);
+	}
+
+	// Readers only wake up for actual changes
+	if (publishedResponse.getVersion() != 0
+		&& response.sampleRate == lastPublishedResponse.sampleRate
+		&& response.stereoMode == lastPublishedResponse.stereoMode
+		&& response.coefficients[0] == lastPublishedResponse.coefficients[0]
+		&& response.coefficients[1] == lastPublishedResponse.coefficients[1])
+		return;
+
+	publishedResponse.write(response);
+	lastPublishedResponse = response;
+}
+
+namespace
+{
+	constexpr double tailDecayInDecibels = -120.0;
+	constexpr double maximumTailLengthInSeconds = 10.0;
+
+	// Samples until a section's impulse response has decayed by tailDecayInDecibels,
+	// from the magnitude of its slowest pole
+	double getDecayLengthInSamples(const CoefficientArray& coefficients, double maximumLength)
+	{
+		const auto a1 = (double)coefficients[4] / coefficients[3];
+		const auto a2 = (double)coefficients[5] / coefficients[3];
+		const auto discriminant = a1 * a1 - 4.0 * a2;
+
+		auto radius = 0.0;
+
+		if (discriminant < 0.0)
+		{
+			radius = std::sqrt(a2);
+		}
+		else
+		{
+			const auto root = std::sqrt(discriminant);
+			radius = 0.5 * juce::jmax(std::abs(-a1 + root), std::abs(-a1 - root));
+		}
+
+		if (radius >= 1.0)
+			return maximumLength;
+
+		// A section's own two samples of delay, plus the pole decay
+		if (radius < 1.0e-9)
+			return 2.0;
+
+		return juce::jmin(maximumLength, 2.0 + std::log(juce::Decibels::decibelsToGain(tailDecayInDecibels, -1000.0)) / std::log(radius));
+	}
+}
+
+namespace
+{
+	const CoefficientArray passThrough{ 1.f, 0.f, 0.f, 1.f, 0.f, 0.f };
+
+	CoefficientArray normalise(CoefficientArray coefficients)
+	{
+		const auto a0 = coefficients[3];
+
+		for (auto& coefficient : coefficients)
+			coefficient /= a0;
+
+		return coefficients;
+	}
+
+	CoefficientArray interpolate(const CoefficientArray& a, const CoefficientArray& b, float proportion)
+	{
+		CoefficientArray coefficients;
+
+		for (size_t i = 0; i < coefficients.size(); ++i)
+			coefficients[i] = a[i] + proportion * (b[i] - a[i]);
+
+		return coefficients;
+	}
+
+	// The make* functions take either a sample rate or CoefficientTables
+	template <typename Designer>
+	ChainCoefficients designChainCoefficients(const ChainSettings& chainSettings, const Designer& designer)
+	{
+		ChainCoefficients coefficients;
+
+		coefficients.numHighPassSections = chainSettings.highPassSlope + 1;
+		coefficients.numLowPassSections = chainSettings.lowPassSlope + 1;
+
+		const auto highPass = makeHighPassCoefficients(chainSettings, designer);
+		const auto lowPass = makeLowPassCoefficients(chainSettings, designer);
+
+		for (int i = 0; i < 4; ++i)
+		{
+			coefficients.highPass[(size_t)i] = i < coefficients.numHighPassSections ? normalise(highPass[(size_t)i]) : passThrough;
+			coefficients.lowPass[(size_t)i] = i < coefficients.numLowPassSections ? normalise(lowPass[(size_t)i]) : passThrough;
+		}
+
+		coefficients.lowShelf = normalise(makeLowShelfCoefficients(chainSettings, designer));
+		for (int i = 0; i < 3; ++i)
+			coefficients.peaks[i] = normalise(makePeakCoefficients(chainSettings, designer, i));
+		coefficients.highShelf = normalise(makeHighShelfCoefficients(chainSettings, designer));
+
+		return coefficients;
+	}
+}
+
+ChainCoefficients makeChainCoefficients(const ChainSettings& chainSettings, double sampleRate)
+{
+	return designChainCoefficients(chainSettings, sampleRate);
+}
+
+ChainCoefficients makeChainCoefficients(const ChainSettings& chainSettings, const CoefficientTables& tables)
+{
+	return designChainCoefficients(chainSettings, tables);
+}
+
+ChainCoefficients interpolateChainCoefficients(const ChainCoefficients& a, const ChainCoefficients& b, float proportion)
+{
+	ChainCoefficients coefficients;
+
+	// Sections missing on one side are pass-throughs, which blend in smoothly
+	coefficients.numHighPassSections = juce::jmax(a.numHighPassSections, b.numHighPassSections);
+	coefficients.numLowPassSections = juce::jmax(a.numLowPassSections, b.numLowPassSections);
+
+	for (size_t i = 0; i < 4; ++i)
+	{
+		coefficients.highPass[i] = interpolate(a.highPass[i], b.highPass[i], proportion);
+		coefficients.lowPass[i] = interpolate(a.lowPass[i], b.lowPass[i], proportion);
+	}
+
+	coefficients.lowShelf = interpolate(a.lowShelf, b.lowShelf, proportion);
+	for (int i = 0; i < 3; ++i)
+		coefficients.peaks[i] = interpolate(a.peaks[i], b.peaks[i], proportion);
+	coefficients.highShelf = interpolate(a.highShelf, b.highShelf, proportion);
+
+	return coefficients;
+}
+
+void applyChainCoefficients(MonoChain& chain, const ChainCoefficients& coefficients)
+{
+	applyCutCoefficients(chain.get<ChainPositions::HighPass>(), coefficients.highPass, coefficients.numHighPassSections);
+	updateCoefficients(chain.get<ChainPositions::LowShelf>().coefficients, coefficients.lowShelf);
+	updateCoefficients(chain.get<ChainPositions::Peak1>().coefficients, coefficients.peaks[0]);
+	updateCoefficients(chain.get<ChainPositions::Peak2>().coefficients, coefficients.peaks[1]);
+	updateCoefficients(chain.get<ChainPositions::Peak3>().coefficients, coefficients.peaks[2]);
+	updateCoefficients(chain.get<ChainPositions::HighShelf>().coefficients, coefficients.highShelf);
+	applyCutCoefficients(chain.get<ChainPositions::LowPass>(), coefficients.lowPass, coefficients.numLowPassSections);
+}
+
+namespace
+{
+	CoefficientArray getSectionCoefficients(const Filter& filter)
+	{
+		// Second order sections are stored normalised, b0, b1, b2, a1, a2
+		if (filter.coefficients->getFilterOrder() != 2)
+			return passThrough;
+
+		const auto* raw = filter.coefficients->getRawCoefficients();
+		return { raw[0], raw[1], raw[2], 1.f, raw[3], raw[4] };
+	}
+
+	template <int Index>
+	void getCutSection(const CutFilter& cutFilter, CutCoefficientArrays& sections, int& numSections)
+	{
+		if (cutFilter.isBypassed<Index>())
+		{
+			sections[Index] = passThrough;
+			return;
+		}
+
+		sections[Index] = getSectionCoefficients(cutFilter.get<Index>());
+		numSections = Index + 1;
+	}
+
+	int getCutCoefficients(const CutFilter& cutFilter, CutCoefficientArrays& sections)
+	{
+		auto numSections = 1;
+
+		getCutSection<0>(cutFilter, sections, numSections);
+		getCutSection<1>(cutFilter, sections, numSections);
+		getCutSection<2>(cutFilter, sections, numSections);
+		getCutSection<3>(cutFilter, sections, numSections);
+
+		return numSections;
+	}
+
+	bool operator==(const ChainCoefficients& a, const ChainCoefficients& b)
+	{
+		return a.highPass == b.highPass && a.lowPass == b.lowPass
+			&& a.lowShelf == b.lowShelf && a.highShelf == b.highShelf
+			&& a.peaks[0] == b.peaks[0] && a.peaks[1] == b.peaks[1] && a.peaks[2] == b.peaks[2]
+			&& a.numHighPassSections == b.numHighPassSections && a.numLowPassSections == b.numLowPassSections;
+	}
+}
+
+ChainCoefficients getChainCoefficients(const MonoChain& chain)
+{
+	ChainCoefficients coefficients;
+
+	coefficients.numHighPassSections = getCutCoefficients(chain.get<ChainPositions::HighPass>(), coefficients.highPass);
+	coefficients.lowShelf = getSectionCoefficients(chain.get<ChainPositions::LowShelf>());
+	coefficients.peaks[0] = getSectionCoefficients(chain.get<ChainPositions::Peak1>());
+	coefficients.peaks[1] = getSectionCoefficients(chain.get<ChainPositions::Peak2>());
+	coefficients.peaks[2] = getSectionCoefficients(chain.get<ChainPositions::Peak3>());
+	coefficients.highShelf = getSectionCoefficients(chain.get<ChainPositions::HighShelf>());
+	coefficients.numLowPassSections = getCutCoefficients(chain.get<ChainPositions::LowPass>(), coefficients.lowPass);
+
+	return coefficients;
+}
+
+double getTailLengthInSamples(const ChainSettings& chainSettings, double sampleRate)
+{
+	if (sampleRate <= 0.0)
+		return 0.0;
+
+	const auto maximumLength = maximumTailLengthInSeconds * sampleRate;
+	auto length = 0.0;
+
+	// Cascaded sections ring one after another, so summing is conservative
+	const auto addCutSections = [&](const CutCoefficientArrays& sections, Slope slope)
+	{
+		for (int i = 0; i <= (int)slope; ++i)
+			length += getDecayLengthInSamples(sections[(size_t)i], maximumLength);
+	};
+
+	addCutSections(makeHighPassCoefficients(chainSettings, sampleRate), chainSettings.highPassSlope);
+	addCutSections(makeLowPassCoefficients(chainSettings, sampleRate), chainSettings.lowPassSlope);
+
+	// At 0 dB the peak and shelf zeros cancel their poles, they don't ring
+	if (chainSettings.lowShelfGainInDecibels != 0.f)
+		length += getDecayLengthInSamples(makeLowShelfCoefficients(chainSettings, sampleRate), maximumLength);
+
+	for (int i = 0; i < 3; ++i)
+		if (chainSettings.peakGainInDecibels[i] != 0.f)
+			length += getDecayLengthInSamples(makePeakCoefficients(chainSettings, sampleRate, i), maximumLength);
+
+	if (chainSettings.highShelfGainInDecibels != 0.f)
+		length += getDecayLengthInSamples(makeHighShelfCoefficients(chainSettings, sampleRate), maximumLength);
+
+	return juce::jmin(length, maximumLength);
+}
+
+namespace
+{
+	// Every band parameter, with an ID suffix so the second settings set can reuse it
+	void addChainParameters(juce::AudioProcessorValueTreeState::ParameterLayout& layout, const juce::String& suffix)
+	{
+		// HighPass Freq
+		layout.add(std::make_unique < juce::AudioParameterFloat >(
+			"HighPass Freq" + suffix,
+			"HighPass Freq" + suffix,
+			juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
+			20.f));
+
+		// LowPass Freq
+		layout.add(std::make_unique < juce::AudioParameterFloat >(
+			"LowPass Freq" + suffix,
+			"LowPass Freq" + suffix,
+			juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
+			20000.f));
+
+		// LowShelf Freq
+		layout.add(std::make_unique < juce::AudioParameterFloat >(
+			"LowShelf Freq" + suffix,
+			"LowShelf Freq" + suffix,
+			juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
+			200.f));
+
+		// LowShelf Gain
+		layout.add(std::make_unique < juce::AudioParameterFloat >(
+			"LowShelf Gain" + suffix,
+			"LowShelf Gain" + suffix,
+			juce::NormalisableRange<float>(-24.f, 24.f, 0.2f, 1.f),
+			0.0f));
+
+		// LowShelf Q
+		layout.add(std::make_unique < juce::AudioParameterFloat >(
+			"LowShelf Q" + suffix,
+			"LowShelf Q" + suffix,
+			juce::NormalisableRange<float>(0.1f, 5.f, 0.05f, 0.5f),
+			1.f));
+
+		// Peak 1 Freq
+		layout.add(std::make_unique < juce::AudioParameterFloat >(
+			"Peak 1 Freq" + suffix,
+			"Peak 1 Freq" + suffix,
+			juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
+			250.f));
+
+		// Peak 1 Gain
+		layout.add(std::make_unique < juce::AudioParameterFloat >(
+			"Peak 1 Gain" + suffix,
+			"Peak 1 Gain" + suffix,
+			juce::NormalisableRange<float>(-24.f, 24.f, 0.2f, 1.f),
+			0.0f));
+
+		// Peak 1 Q
+		layout.add(std::make_unique < juce::AudioParameterFloat >(
+			"Peak 1 Q" + suffix,
+			"Peak 1 Q" + suffix,
+			juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 0.5f),
+			1.f));
+
+		// Peak 2 Freq
+		layout.add(std::make_unique < juce::AudioParameterFloat >(
+			"Peak 2 Freq" + suffix,
+			"Peak 2 Freq" + suffix,
+			juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
+			720.f));
+
+		// Peak 2 Gain
+		layout.add(std::make_unique < juce::AudioParameterFloat >(
+			"Peak 2 Gain" + suffix,
+			"Peak 2 Gain" + suffix,
+			juce::NormalisableRange<float>(-24.f, 24.f, 0.2f, 1.f),
+			0.0f));
+
+		// Peak 2 Q
+		layout.add(std::make_unique < juce::AudioParameterFloat >(
+			"Peak 2 Q" + suffix,
+			"Peak 2 Q" + suffix,
+			juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 0.5f),
+			1.f));
+
+		// Peak 3 Freq
+		layout.add(std::make_unique < juce::AudioParameterFloat >(
+			"Peak 3 Freq" + suffix,
+			"Peak 3 Freq" + suffix,
+			juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
+			2000.f));
+
+		// Peak 3 Gain
+		layout.add(std::make_unique < juce::AudioParameterFloat >(
+			"Peak 3 Gain" + suffix,
+			"Peak 3 Gain" + suffix,
+			juce::NormalisableRange<float>(-24.f, 24.f, 0.2f, 1.f),
+			0.0f));
+
+		// Peak 3 Q
+		layout.add(std::make_unique < juce::AudioParameterFloat >(
+			"Peak 3 Q" + suffix,
+			"Peak 3 Q" + suffix,
+			juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 0.5f),
+			1.f));
+
+		// HighShelf Freq
+		layout.add(std::make_unique < juce::AudioParameterFloat >(
+			"HighShelf Freq" + suffix,
+			"HighShelf Freq" + suffix,
+			juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
+			2000.f));
+
+		// HighShelf Gain
+		layout.add(std::make_unique < juce::AudioParameterFloat >(
+			"HighShelf Gain" + suffix,
+			"HighShelf Gain" + suffix,
+			juce::NormalisableRange<float>(-24.f, 24.f, 0.2f, 1.f),
+			0.0f));
+
+		// HighShelf Q
+		layout.add(std::make_unique < juce::AudioParameterFloat >(
+			"HighShelf Q" + suffix,
+			"HighShelf Q" + suffix,
+			juce::NormalisableRange<float>(0.1f, 5.f, 0.05f, 0.5f),
+			1.f));
+
+		// LowPass/HighPass Options
+		juce::StringArray stringArray;
+		for (int i = 0; i < 4; i++)
+		{
+			juce::String str;
+			str << (12 + i * 12);
+			str << " db/Oct";
+			stringArray.add(str);
+		}
+
+		// HighPass Slope
+		layout.add(std::make_unique < juce::AudioParameterChoice >(
+			"HighPass Slope" + suffix,
+			"HighPass Slope" + suffix,
+			stringArray,
+			0));
+
+		// LowPass Slope
+		layout.add(std::make_unique < juce::AudioParameterChoice >(
+			"LowPass Slope" + suffix,
+			"LowPass Slope" + suffix,
+			stringArray,
+			0));
+
+		// Dynamics of the peak and shelf bands
+		for (auto* band : dynamicBandNames)
+		{
+			const juce::String name{ band };
+
+			layout.add(std::make_unique < juce::AudioParameterBool >(
+				name + " Dynamic" + suffix,
+				name + " Dynamic" + suffix,
+				false));
+
+			layout.add(std::make_unique < juce::AudioParameterFloat >(
+				name + " Threshold" + suffix,
+				name + " Threshold" + suffix,
+				juce::NormalisableRange<float>(-60.f, 0.f, 0.1f, 1.f),
+				0.f));
+
+			layout.add(std::make_unique < juce::AudioParameterFloat >(
+				name + " Ratio" + suffix,
+				name + " Ratio" + suffix,
+				juce::NormalisableRange<float>(1.f, 20.f, 0.1f, 0.4f),
+				2.f));
+
+			layout.add(std::make_unique < juce::AudioParameterFloat >(
+				name + " Attack" + suffix,
+				name + " Attack" + suffix,
+				juce::NormalisableRange<float>(0.1f, 200.f, 0.1f, 0.4f),
+				10.f));
+
+			layout.add(std::make_unique < juce::AudioParameterFloat >(
+				name + " Release" + suffix,
+				name + " Release" + suffix,
+				juce::NormalisableRange<float>(5.f, 2000.f, 1.f, 0.4f),
+				100.f));
+		}
+	}
+}
+
+juce::AudioProcessorValueTreeState::ParameterLayout SimpleEQAudioProcessor::createParameterLayout()
+{
+	juce::AudioProcessorValueTreeState::ParameterLayout layout;
+
+	addChainParameters(layout, {});
+
+	// Filter Topology
+	layout.add(std::make_unique < juce::AudioParameterChoice >(
+		"Filter Topology",
+		"Filter Topology",
+		juce::StringArray{ "Biquad", "SVF" },
+		0));
+
+	// Stereo Mode
+	layout.add(std::make_unique < juce::AudioParameterChoice >(
+		"Stereo Mode",
+		"Stereo Mode",
+		juce::StringArray{ "Linked", "Left/Right", "Mid/Side" },
+		0));
+
+	// Morph between two stored snapshots
+	const juce::StringArray snapshotNames{ "A", "B", "C", "D" };
+
+	layout.add(std::make_unique < juce::AudioParameterBool >(
+		"Morph Enabled",
+		"Morph Enabled",
+		false));
+
+	layout.add(std::make_unique < juce::AudioParameterChoice >(
+		"Morph From",
+		"Morph From",
+		snapshotNames,
+		0));
+
+	layout.add(std::make_unique < juce::AudioParameterChoice >(
+		"Morph To",
+		"Morph To",
+		snapshotNames,
+		1));
+
+	layout.add(std::make_unique < juce::AudioParameterFloat >(
+		"Morph",
+		"Morph",
+		juce::NormalisableRange<float>(0.f, 1.f, 0.001f, 1.f),
+		0.f));
+
+	// Loudness Meter
+	layout.add(std::make_unique < juce::AudioParameterBool >(
+		"Loudness Meter",
+		"Loudness Meter",
+		false));
+
+	// Auto Gain, matches the output's short-term loudness to the input's
+	layout.add(std::make_unique < juce::AudioParameterBool >(
+		"Auto Gain",
+		"Auto Gain",
+		false));
+
+	addChainParameters(layout, secondChainSuffix);
+
+	// Oversampling, selective modes only move the bands close to Nyquist
+	layout.add(std::make_unique < juce::AudioParameterChoice >(
+		"Oversampling",
+		"Oversampling",
+		juce::StringArray{ "Off", "2x Selective", "4x Selective", "2x Full", "4x Full" },
+		0));
+
+	layout.add(std::make_unique < juce::AudioParameterChoice >(
+		"Oversampling Filter",
+		"Oversampling Filter",
+		juce::StringArray{ "Polyphase IIR", "Linear Phase FIR" },
+		0));
+
+	// Linkwitz-Riley band split after the EQ
+	addCrossoverParameters(layout);
 
 	return layout;
 }
@@ -9,6 +9,20 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "SvfFilter.h"
+#include "BlockBiquad.h"
+#include "ParameterEvents.h"
+#include "DynamicsDetector.h"
+#include "LoudnessMeter.h"
+#include "BinaryState.h"
+#include "PresetBank.h"
+#include "SpectrumAnalyzer.h"
+#include "CoefficientTables.h"
+#include "SeqLock.h"
+
+class MatchEqFitter;
+class Crossover;
+struct CrossoverParameters;
 
 enum Slope
 {
@@ -18,6 +32,44 @@ enum Slope
     Slope_48,
 };
 
+enum Topology
+{
+    Topology_Biquad,
+    Topology_Svf,
+};
+
+enum StereoMode
+{
+    StereoMode_Linked,
+    StereoMode_LeftRight,
+    StereoMode_MidSide,
+};
+
+// Selective modes run only the stages with corners close to Nyquist at the
+// higher rate, full modes run the whole chain there
+enum OversamplingMode
+{
+    Oversampling_Off,
+    Oversampling_2xSelective,
+    Oversampling_4xSelective,
+    Oversampling_2xFull,
+    Oversampling_4xFull,
+};
+
+enum ChannelMask
+{
+    Channel_Left = 1,
+    Channel_Right = 2,
+    Channel_Both = 3,
+};
+
+// ID suffix of the second set of band parameters, which drives the right channel
+// in Left/Right mode and the side channel in Mid/Side mode
+inline const juce::String secondChainSuffix{ " B" };
+
+// Bands that can follow an envelope, in chain order: LowShelf, Peak 1-3, HighShelf
+constexpr int numDynamicBands = 5;
+
 struct ChainSettings
 {
     float peakFreq[3]{0}, peakGainInDecibels[3]{0}, peakQ[3]{1.f};
@@ -25,11 +77,46 @@ struct ChainSettings
     float lowShelfFreq{ 0 }, lowShelfGainInDecibels{ 0 }, lowShelfQ{1.f};
     float highShelfFreq{ 0 }, highShelfGainInDecibels{ 0 }, highShelfQ{ 1.f };
     Slope highPassSlope{ Slope::Slope_12 }, lowPassSlope{ Slope::Slope_12 };
+    Topology topology{ Topology::Topology_Biquad };
+    BandDynamics dynamics[numDynamicBands];
 };
 
 ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts);
 
+// Sets the field behind an unsuffixed parameter ID, in plain units, for code
+// that drives the chains without a processor. Returns the bands to redesign,
+// or nothing if the ID isn't a chain parameter.
+std::optional<juce::uint32> setChainParameter(ChainSettings& chainSettings, const juce::String& parameterID, float value);
+
+// Left/mid and right/side settings, identical in Linked mode
+using StereoSettings = std::array<ChainSettings, 2>;
+using StereoBands = std::array<juce::uint32, 2>;
+
+// The raw values behind one ChainSettings, looked up once by ID so the audio
+// thread doesn't search the parameter tree every block
+struct ChainParameters
+{
+    void attach(juce::AudioProcessorValueTreeState& apvts, const juce::String& suffix);
+    ChainSettings load() const;
+
+private:
+    std::vector<std::atomic<float>*> values;
+};
+
+// Frequencies glide geometrically, gains and Qs linearly, slopes and topology jump to b
+ChainSettings interpolateChainSettings(const ChainSettings& a, const ChainSettings& b, float proportion);
+
+// Processes each MonoChain stage several samples per iteration, set to 0 to use
+// juce::dsp::IIR::Filter instead
+#ifndef SIMPLEEQ_USE_BLOCK_BIQUAD
+ #define SIMPLEEQ_USE_BLOCK_BIQUAD 1
+#endif
+
+#if SIMPLEEQ_USE_BLOCK_BIQUAD
+using Filter = BlockBiquad;
+#else
 using Filter = juce::dsp::IIR::Filter<float>;
+#endif
 
 using CutFilter = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter>;
 
@@ -46,9 +133,64 @@ enum ChainPositions
     LowPass
 };
 
+// One bit per ChainPositions entry, used to redesign only the bands that changed
+inline constexpr juce::uint32 getBandMask(int chainPosition)
+{
+    return 1u << chainPosition;
+}
+
+constexpr juce::uint32 allBands = 0x7f;
+
+inline constexpr int getDynamicBandPosition(int dynamicBand)
+{
+    return ChainPositions::LowShelf + dynamicBand;
+}
+
+juce::uint32 getChangedBands(const ChainSettings& a, const ChainSettings& b);
+
 using Coefficients = Filter::CoefficientsPtr;
 void updateCoefficients(Coefficients& old, const Coefficients& replacements);
 
+// b0, b1, b2, a0, a1, a2 as produced by juce::dsp::IIR::ArrayCoefficients.
+// Assigning these to an existing Coefficients object doesn't allocate.
+using CoefficientArray = std::array<float, 6>;
+using CutCoefficientArrays = std::array<CoefficientArray, 4>;
+void updateCoefficients(Coefficients& old, const CoefficientArray& replacements);
+
+CoefficientArray makePeakCoefficients(const ChainSettings& chainSettings, double sampleRate, int filterNr);
+CoefficientArray makeLowShelfCoefficients(const ChainSettings& chainSettings, double sampleRate);
+CoefficientArray makeHighShelfCoefficients(const ChainSettings& chainSettings, double sampleRate);
+CutCoefficientArrays makeHighPassCoefficients(const ChainSettings& chainSettings, double sampleRate);
+CutCoefficientArrays makeLowPassCoefficients(const ChainSettings& chainSettings, double sampleRate);
+
+// The same designs from precomputed tables, a few loads and multiply-adds
+// instead of the trigonometry, at the tables' sample rate
+CoefficientArray makePeakCoefficients(const ChainSettings& chainSettings, const CoefficientTables& tables, int filterNr);
+CoefficientArray makeLowShelfCoefficients(const ChainSettings& chainSettings, const CoefficientTables& tables);
+CoefficientArray makeHighShelfCoefficients(const ChainSettings& chainSettings, const CoefficientTables& tables);
+CutCoefficientArrays makeHighPassCoefficients(const ChainSettings& chainSettings, const CoefficientTables& tables);
+CutCoefficientArrays makeLowPassCoefficients(const ChainSettings& chainSettings, const CoefficientTables& tables);
+
+// Every stage's coefficients for one ChainSettings, normalised so a0 is 1.
+// Designed ahead of time, they can be swapped into a MonoChain or interpolated
+// without a redesign. Unused cut sections hold a pass-through.
+struct ChainCoefficients
+{
+    CutCoefficientArrays highPass{}, lowPass{};
+    CoefficientArray lowShelf{}, peaks[3]{}, highShelf{};
+    int numHighPassSections{ 1 }, numLowPassSections{ 1 };
+};
+
+ChainCoefficients makeChainCoefficients(const ChainSettings& chainSettings, double sampleRate);
+ChainCoefficients makeChainCoefficients(const ChainSettings& chainSettings, const CoefficientTables& tables);
+
+// Linear in the coefficients. The stable region of a second order section is
+// convex, so anything between two stable designs is stable too.
+ChainCoefficients interpolateChainCoefficients(const ChainCoefficients& a, const ChainCoefficients& b, float proportion);
+
+// How long the designed chain keeps ringing after its input stops, from its poles
+double getTailLengthInSamples(const ChainSettings& chainSettings, double sampleRate);
+
 Coefficients makePeakFilter(const ChainSettings& chainSettings, double sampleRate, int filterNr);
 Coefficients makeLowShelfFilter(const ChainSettings& chainSettings, double sampleRate);
 Coefficients makeHighShelfFilter(const ChainSettings& chainSettings, double sampleRate);
@@ -93,6 +235,68 @@ void updateCutFilter(
 
 }
 
+template<int Index, typename ChainType>
+void updateSvf(ChainType& chain, SvfType type, float frequency, int order)
+{
+    chain.template get<Index>().setParameters(type, frequency, getButterworthQ(order, Index), 0.f);
+    chain.template setBypassed<Index>(false);
+}
+
+template<typename ChainType>
+void updateSvfCutFilter(
+    ChainType& chain,
+    SvfType type,
+    float frequency,
+    const Slope& slope)
+{
+    const auto order = 2 * (slope + 1);
+
+    chain.template setBypassed<0>(true);
+    chain.template setBypassed<1>(true);
+    chain.template setBypassed<2>(true);
+    chain.template setBypassed<3>(true);
+
+    switch (slope)
+    {
+    case Slope_48:
+    {
+        updateSvf<3>(chain, type, frequency, order);
+    }
+    case Slope_36:
+    {
+        updateSvf<2>(chain, type, frequency, order);
+    }
+    case Slope_24:
+    {
+        updateSvf<1>(chain, type, frequency, order);
+    }
+    case Slope_12:
+    {
+        updateSvf<0>(chain, type, frequency, order);
+    }
+    }
+}
+
+template<int Index>
+void applyCutSection(CutFilter& cutFilter, const CutCoefficientArrays& sections, int numSections)
+{
+    updateCoefficients(cutFilter.get<Index>().coefficients, sections[Index]);
+    cutFilter.setBypassed<Index>(Index >= numSections);
+}
+
+inline void applyCutCoefficients(CutFilter& cutFilter, const CutCoefficientArrays& sections, int numSections)
+{
+    applyCutSection<0>(cutFilter, sections, numSections);
+    applyCutSection<1>(cutFilter, sections, numSections);
+    applyCutSection<2>(cutFilter, sections, numSections);
+    applyCutSection<3>(cutFilter, sections, numSections);
+}
+
+void applyChainCoefficients(MonoChain& chain, const ChainCoefficients& coefficients);
+
+// The reverse, what a chain is running right now. Bypassed cut sections read as pass-throughs.
+ChainCoefficients getChainCoefficients(const MonoChain& chain);
+
 inline auto makeHighPassFilter(const ChainSettings& chainSettings, double sampleRate)
 {
     return juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(
@@ -116,6 +320,7 @@ class SimpleEQAudioProcessor  : public juce::AudioProcessor
                             #if JucePlugin_Enable_ARA
                              , public juce::AudioProcessorARAExtension
                             #endif
+                             , private juce::AsyncUpdater
 {
 public:
     //==============================================================================
@@ -155,19 +360,237 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
 
+    // Recalls a preset straight from the bank's mapping
+    bool loadPreset(const PresetBank& bank, int index);
+
+    // Parameters must only ever be appended here, the binary state format
+    // stores them by position
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     juce::AudioProcessorValueTreeState apvts{ *this, nullptr, "Parameters", createParameterLayout()};
 
+    // Queues a sample-accurate automation event for the next processBlock call.
+    // Meant for hosts and harnesses that know event offsets; the parameter itself
+    // should still be set to its final value as usual. Call from the audio thread,
+    // in ascending sampleOffset order; earlier offsets are rejected.
+    bool addParameterEvent(int sampleOffset, int parameterIndex, float newValue);
+
+    // Shortest sub-block processBlock will split into, bounding the worst-case
+    // number of redesigns per block when automation lanes are dense.
+    void setAutomationGranularity(int numSamples);
+    int getAutomationGranularity() const { return automationGranularity; }
+
+    // BS.1770 loudness before and after the EQ, while "Loudness Meter" or "Auto Gain" is on
+    const LoudnessMeter& getInputMeter() const { return inputMeter; }
+    const LoudnessMeter& getOutputMeter() const { return outputMeter; }
+    float getAutoGainInDecibels() const { return autoGainInDecibels.load(); }
+
+    // A/B/C/D snapshots of every parameter, with their coefficients designed up
+    // front. Storing and recalling happen on the message thread; the "Morph"
+    // parameters blend between two stored snapshots.
+    static constexpr int numSnapshots = 4;
+    void storeSnapshot(int slot);
+    bool recallSnapshot(int slot);
+    bool hasSnapshot(int slot) const;
+
+    // Match EQ: capture the input's average spectrum once while a reference
+    // plays and once with the material to match, then fit the bands to the
+    // difference on a background thread. Message thread.
+    SpectrumAnalyzer& getMatchAnalyzer() { return matchAnalyzer; }
+    bool startMatchFit();
+    bool isMatchFitRunning() const;
+
+    // Sets the first set of band parameters from a finished fit, false while there is none
+    bool applyMatchFit();
+
+    // The coefficients the chains are running, gain reduction and morphing
+    // included. Republished from the audio thread whenever they change, so
+    // editors can draw the response without designing anything themselves.
+    struct PublishedResponse
+    {
+        double sampleRate{ 0.0 };
+        StereoMode stereoMode{ StereoMode::StereoMode_Linked };
+        std::array<ChainCoefficients, 2> coefficients;
+    };
+
+    // Lock-free, any thread, any number of readers. The version goes up with
+    // every change and is 0 until prepareToPlay.
+    juce::uint32 getResponseVersion() const noexcept { return publishedResponse.getVersion(); }
+    juce::uint32 readResponse(PublishedResponse& response) const noexcept { return publishedResponse.read(response); }
+
 private:
     MonoChain leftChain, rightChain;
+    SvfMonoChain leftSvfChain, rightSvfChain;
+
+    // Band designs at the host rate and at 2x and 4x, set in prepareToPlay
+    std::shared_ptr<const CoefficientTables> coefficientTables;
+    std::shared_ptr<const CoefficientTables> oversampledCoefficientTables[2];
+    Topology currentTopology{ Topology::Topology_Biquad };
+
+    StereoMode currentStereoMode{ StereoMode::StereoMode_Linked };
+    std::atomic<float>* stereoModeParameter{ nullptr };
+    ChainParameters chainParameters[2];
+
+    StereoSettings appliedSettings;
+    ParameterEventQueue parameterEvents;
+    int automationGranularity{ 16 };
+
+    struct ParameterTargetIndex
+    {
+        int target{ -1 };
+        int chain{ 0 };
+    };
+
+    std::vector<ParameterTargetIndex> parameterTargets;
+
+    LoudnessMeter inputMeter, outputMeter;
+
+    SpectrumAnalyzer matchAnalyzer;
+    std::unique_ptr<MatchEqFitter> matchFitter;
+
+    // Splits the EQ's output into bands, with outputs on the "Band n" buses
+    std::unique_ptr<Crossover> crossover;
+    std::unique_ptr<CrossoverParameters> crossoverParameters;
+    std::atomic<float>* loudnessMeterParameter{ nullptr };
+    std::atomic<float>* autoGainParameter{ nullptr };
+
+    static constexpr float maximumAutoGainInDecibels = 24.f;
+    static constexpr double autoGainRampLengthInSeconds = 0.5;
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> autoGain{ 1.f };
+    float autoGainTargetInDecibels{ 0.f };
+    std::atomic<float> autoGainInDecibels{ 0.f };
+
+    struct Snapshot
+    {
+        bool valid{ false };
+        std::vector<float> parameterValues;     // normalised, in getParameters() order
+        StereoMode stereoMode{ StereoMode::StereoMode_Linked };
+        StereoSettings settings;
+        std::array<ChainCoefficients, 2> coefficients;
+    };
+
+    // Held by the message thread only to swap a slot in, the audio thread
+    // never waits for it
+    juce::SpinLock snapshotLock;
+    std::array<Snapshot, numSnapshots> snapshots;
+    std::atomic<int> pendingRecall{ -1 };
+    std::atomic<bool> snapshotsChanged{ false };
+
+    // What a morph needs from its two snapshots, copied out under snapshotLock
+    // each block. No vectors, so the copy doesn't allocate.
+    struct MorphEndpoint
+    {
+        StereoSettings settings;
+        std::array<ChainCoefficients, 2> coefficients;
+    };
+
+    MorphEndpoint morphFrom, morphTo;
+
+    std::atomic<float>* morphParameter{ nullptr };
+    std::atomic<float>* morphEnabledParameter{ nullptr };
+    std::atomic<float>* morphFromParameter{ nullptr };
+    std::atomic<float>* morphToParameter{ nullptr };
+    // Morph amount the chains were last set to, negative when not morphing
+    float currentMorph{ -1.f };
+
+    // Band gains follow the detectors at this rate rather than per sample
+    static constexpr int dynamicsControlInterval = 32;
+    // Smaller gain reduction changes don't trigger a redesign
+    static constexpr float gainReductionHysteresis = 0.1f;
+
+    DynamicsDetector detectors[2];
+    StereoSettings detectorSettings;
+    bool detectorsValid{ false };
+    bool dynamicsActive{ false };
+
+    // Decibels currently taken off each dynamic band, per chain, already
+    // included in the designed coefficients
+    float gainReduction[2][numDynamicBands]{};
+
+    // Input below this magnitude (-120 dB) counts as silence
+    static constexpr float silenceThreshold = 1.0e-6f;
+
+    // Oversampling. A band moves to the oversampled chains once its corner passes
+    // the enter ratio of the host rate and back once it drops below the leave
+    // ratio; the gap stops a swept band from flipping back and forth.
+    static constexpr float oversamplingEnterRatio = 0.3f;
+    static constexpr float oversamplingLeaveRatio = 0.27f;
+
+    // [2x, 4x][polyphase IIR, equiripple FIR], all prepared so switching never allocates
+    std::unique_ptr<juce::dsp::Oversampling<float>> oversamplers[2][2];
+    juce::dsp::Oversampling<float>* activeOversampler{ nullptr };
+    OversamplingMode currentOversamplingMode{ OversamplingMode::Oversampling_Off };
+    int currentOversamplingFilter{ 0 };
+    std::atomic<float>* oversamplingParameter{ nullptr };
+    std::atomic<float>* oversamplingFilterParameter{ nullptr };
+    std::atomic<int> oversamplingLatency{ 0 };
+    // What the oversamplers were initialised for, processChains never passes them more
+    int oversamplingBlockSize{ 1 };
+
+    MonoChain leftOversampledChain, rightOversampledChain;
+    // Bands running at the higher rate, bypassed in leftChain and rightChain
+    juce::uint32 oversampledBands{ 0 };
+    // What the oversampled chains were designed from, gain reductions included
+    StereoSettings oversampledSettings;
+    bool oversampledSettingsValid{ false };
+
+    SeqLock<PublishedResponse> publishedResponse;
+    // Audio thread's copy of the last one published, to spot changes
+    PublishedResponse lastPublishedResponse;
+
+    std::atomic<double> tailLengthSeconds{ 0.0 };
+    StereoSettings tailSettings;
+    bool tailLengthValid{ false };
+    int tailLengthSamples{ 0 };
+    int silentSamples{ 0 };
+    bool skippingSilence{ false };
+
+    template <typename Callback>
+    void forEachChain(juce::uint32 channels, Callback&& callback)
+    {
+        if (channels & Channel_Left)
+            callback(leftChain);
+        if (channels & Channel_Right)
+            callback(rightChain);
+    }
+
+    void updatePeakFilter(const ChainSettings& chainSettings, int filterNr, juce::uint32 channels);
+
+    void updateLowShelfFilters(const ChainSettings& chainSettings, juce::uint32 channels);
+    void updateHighShelfFilters(const ChainSettings& chainSettings, juce::uint32 channels);
+
+    void updateHighPassFilters(const ChainSettings& chainSettings, juce::uint32 channels);
+    void updateLowPassFilters(const ChainSettings& chainSettings, juce::uint32 channels);
+
+    void updateSvfFilters(const ChainSettings& chainSettings, juce::uint32 bands, juce::uint32 channels);
+
+    void designBands(const ChainSettings& chainSettings, juce::uint32 bands, juce::uint32 channels);
+
+    StereoSettings getTargetSettings() const;
+    void applySettings(const ChainSettings& chainSettings, juce::uint32 bands, juce::uint32 channels);
+    void applyStereoSettings(const StereoSettings& settings, StereoBands bands);
+    StereoBands getChangedStereoBands(const StereoSettings& settings) const;
+    StereoBands applyParameterEvent(const ParameterEvent& event, StereoSettings& settings) const;
+    void processWithAutomation(juce::dsp::AudioBlock<float>& block, const StereoSettings& targetSettings);
+    void processSubBlock(juce::dsp::AudioBlock<float>& block);
+    void processChains(juce::dsp::AudioBlock<float>& block);
+    void applyAutoGain(juce::AudioBuffer<float>& buffer, bool enabled);
 
-    void updatePeakFilter(const ChainSettings& chainSettings, int filterNr);
+    StereoSettings getSettingsFromParameterValues(const std::vector<float>& parameterValues, StereoMode stereoMode) const;
+    void designSnapshot(Snapshot& snapshot, double sampleRate) const;
+    void applySnapshot(const Snapshot& snapshot);
+    void applyMorph(const MorphEndpoint& from, const MorphEndpoint& to, float proportion);
+    void processWithMorph(juce::dsp::AudioBlock<float>& block, const MorphEndpoint& from, const MorphEndpoint& to, float morph);
+    void updateDetectors(const StereoSettings& settings);
+    void updateGainReduction();
+    void resetChains();
 
-    void updateLowShelfFilters(const ChainSettings& chainSettings);
-    void updateHighShelfFilters(const ChainSettings& chainSettings);
+    bool updateOversampling(bool force);
+    void routeOversampledBands(juce::uint32 bands);
+    void updateOversampledChains();
+    void handleAsyncUpdate() override;
 
-    void updateHighPassFilters(const ChainSettings& chainSettings);
-    void updateLowPassFilters(const ChainSettings& chainSettings);
+    void updateTailLength();
+    void publishResponse();
 
     void updateFilters();
 
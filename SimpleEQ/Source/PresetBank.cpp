@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+    PresetBank.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "PresetBank.h"
+
+PresetBank::PresetBank(const juce::File& file)
+{
+    auto mapped = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+
+    const auto* bytes = static_cast<const char*>(mapped->getData());
+    const auto mappedSize = mapped->getSize();
+
+    if (bytes == nullptr || mappedSize < headerSize
+        || juce::ByteOrder::littleEndianInt(bytes) != magic
+        || juce::ByteOrder::littleEndianInt(bytes + 4) > version)
+        return;
+
+    const auto count = (size_t)juce::ByteOrder::littleEndianInt(bytes + 8);
+
+    if (count > (mappedSize - headerSize) / indexEntrySize)
+        return;
+
+    mapping = std::move(mapped);
+    data = bytes;
+    size = mappedSize;
+    numPresets = (int)count;
+}
+
+juce::uint32 PresetBank::readIndex(int index, int field) const noexcept
+{
+    return juce::ByteOrder::littleEndianInt(data + headerSize + (size_t)index * indexEntrySize + (size_t)field * 4);
+}
+
+const char* PresetBank::getName(int index) const noexcept
+{
+    if (! juce::isPositiveAndBelow(index, numPresets))
+        return nullptr;
+
+    const auto offset = (size_t)readIndex(index, 0);
+    const auto end = (size_t)readIndex(index, 1);
+
+    // The name runs up to its state, and must be terminated before it
+    if (offset >= end || end > size || std::memchr(data + offset, 0, end - offset) == nullptr)
+        return nullptr;
+
+    return data + offset;
+}
+
+const void* PresetBank::getStateData(int index) const noexcept
+{
+    if (! juce::isPositiveAndBelow(index, numPresets))
+        return nullptr;
+
+    const auto offset = (size_t)readIndex(index, 1);
+    const auto length = (size_t)readIndex(index, 2);
+
+    if (offset > size || length > size - offset)
+        return nullptr;
+
+    return data + offset;
+}
+
+int PresetBank::getStateSize(int index) const noexcept
+{
+    return getStateData(index) != nullptr ? (int)readIndex(index, 2) : 0;
+}
+
+bool PresetBank::write(const juce::File& file, const std::vector<Preset>& presets)
+{
+    juce::MemoryOutputStream stream;
+
+    stream.writeInt((int)magic);
+    stream.writeInt((int)version);
+    stream.writeInt((int)presets.size());
+    stream.writeInt(0);
+
+    // Lay the records out first so the index can point at them
+    std::vector<juce::uint32> nameOffsets, stateOffsets;
+    auto offset = headerSize + presets.size() * indexEntrySize;
+
+    for (const auto& preset : presets)
+    {
+        nameOffsets.push_back((juce::uint32)offset);
+        offset += preset.name.getNumBytesAsUTF8() + 1;
+        offset = (offset + 3) & ~(size_t)3;
+
+        stateOffsets.push_back((juce::uint32)offset);
+        offset += preset.state.getSize();
+    }
+
+    if (offset > std::numeric_limits<juce::uint32>::max())
+        return false;
+
+    for (size_t i = 0; i < presets.size(); ++i)
+    {
+        stream.writeInt((int)nameOffsets[i]);
+        stream.writeInt((int)stateOffsets[i]);
+        stream.writeInt((int)presets[i].state.getSize());
+        stream.writeInt(0);
+    }
+
+    for (size_t i = 0; i < presets.size(); ++i)
+    {
+        stream.write(presets[i].name.toRawUTF8(), presets[i].name.getNumBytesAsUTF8() + 1);
+
+        while (stream.getPosition() < (juce::int64)stateOffsets[i])
+            stream.writeByte(0);
+
+        stream.write(presets[i].state.getData(), presets[i].state.getSize());
+    }
+
+    return file.replaceWithData(stream.getData(), stream.getDataSize());
+}
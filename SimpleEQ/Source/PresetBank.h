@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    PresetBank.h
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// A read-only library of presets in a single memory-mapped file.
+//
+// Layout, all integers little-endian uint32:
+//   header   magic "SEQB", version, number of presets, reserved
+//   index    per preset: name offset, state offset, state size, reserved
+//   records  null-terminated UTF-8 name, padded to 4 bytes, then the state
+//
+// Opening a bank maps the file and reads nothing else. Names and states are
+// looked up through the index and returned as pointers into the mapping, so
+// browsing and recall cost the same for the first preset as for the ten
+// thousandth and never copy. Offsets are 32 bit, which limits a bank to 4 GB.
+class PresetBank
+{
+public:
+    explicit PresetBank(const juce::File& file);
+
+    bool isValid() const noexcept { return mapping != nullptr; }
+    int getNumPresets() const noexcept { return numPresets; }
+
+    // Null-terminated UTF-8 inside the mapping, or nullptr if out of range
+    const char* getName(int index) const noexcept;
+
+    // A state for setStateInformation, or nullptr if out of range
+    const void* getStateData(int index) const noexcept;
+    int getStateSize(int index) const noexcept;
+
+    struct Preset
+    {
+        juce::String name;
+        juce::MemoryBlock state;
+    };
+
+    static bool write(const juce::File& file, const std::vector<Preset>& presets);
+
+    static constexpr juce::uint32 magic = 0x42514553;  // "SEQB"
+    static constexpr juce::uint32 version = 1;
+
+private:
+    static constexpr size_t headerSize = 16;
+    static constexpr size_t indexEntrySize = 16;
+
+    juce::uint32 readIndex(int index, int field) const noexcept;
+
+    std::unique_ptr<juce::MemoryMappedFile> mapping;
+    const char* data{ nullptr };
+    size_t size{ 0 };
+    int numPresets{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetBank)
+};
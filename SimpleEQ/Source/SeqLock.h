@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    SeqLock.h
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// A value written by one thread and read by any number of others, with no
+// locks. The writer never waits, so it can be the audio thread; a reader that
+// overlaps a write just reads again. The value is copied word by word through
+// relaxed atomics, so the copy itself is never a data race.
+template <typename Value>
+class SeqLock
+{
+public:
+    static_assert(std::is_trivially_copyable_v<Value>, "SeqLock copies its value as raw words");
+
+    // Only ever from one thread at a time
+    void write(const Value& value) noexcept
+    {
+        Words words;
+        std::memcpy(words.data(), &value, sizeof(Value));
+
+        const auto sequence = counter.load(std::memory_order_relaxed);
+        counter.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < numWords; ++i)
+            storage[i].store(words[i], std::memory_order_relaxed);
+
+        counter.store(sequence + 2, std::memory_order_release);
+    }
+
+    // Goes up by one with every write, 0 until the first
+    juce::uint32 getVersion() const noexcept
+    {
+        return counter.load(std::memory_order_acquire) / 2;
+    }
+
+    // Copies the latest value into destination and returns its version.
+    // Leaves destination alone and returns 0 if nothing was written yet.
+    juce::uint32 read(Value& destination) const noexcept
+    {
+        Words words;
+        juce::uint32 before = 0;
+
+        for (;;)
+        {
+            before = counter.load(std::memory_order_acquire);
+
+            if (before == 0)
+                return 0;
+
+            // A write is in progress
+            if ((before & 1) != 0)
+                continue;
+
+            for (size_t i = 0; i < numWords; ++i)
+                words[i] = storage[i].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (counter.load(std::memory_order_relaxed) == before)
+                break;
+        }
+
+        // The version the copy was validated against, a write since then is newer
+        std::memcpy(&destination, words.data(), sizeof(Value));
+        return before / 2;
+    }
+
+private:
+    static constexpr size_t numWords = (sizeof(Value) + sizeof(juce::uint32) - 1) / sizeof(juce::uint32);
+    using Words = std::array<juce::uint32, numWords>;
+
+    std::atomic<juce::uint32> counter{ 0 };
+    std::array<std::atomic<juce::uint32>, numWords> storage{};
+};
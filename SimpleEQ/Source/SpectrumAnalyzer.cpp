@@ -0,0 +1,170 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyzer.h"
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+    if (allocated.load())
+        analysisThread->removeTimeSliceClient(this);
+}
+
+void SpectrumAnalyzer::allocate()
+{
+    fifoData.resize((size_t)fifoCapacity);
+    frame.resize((size_t)fftSize);
+    fftData.resize((size_t)(2 * fftSize));
+    fft = std::make_unique<juce::dsp::FFT>(fftOrder);
+    window = std::make_unique<juce::dsp::WindowingFunction<float>>((size_t)fftSize, juce::dsp::WindowingFunction<float>::hann, false);
+
+    {
+        const juce::ScopedLock lock(averageLock);
+
+        for (auto& sums : powerSums)
+            sums.assign((size_t)numBins, 0.0);
+    }
+
+    allocated.store(true);
+    analysisThread->addTimeSliceClient(this);
+}
+
+void SpectrumAnalyzer::prepare(double newSampleRate)
+{
+    // Averages taken at another rate have their bins in other places
+    if (newSampleRate != sampleRate.exchange(newSampleRate))
+    {
+        const juce::ScopedLock lock(averageLock);
+
+        for (int slot = 0; slot < numSlots; ++slot)
+        {
+            std::fill(powerSums[slot].begin(), powerSums[slot].end(), 0.0);
+            numFrames[slot] = 0;
+        }
+    }
+}
+
+void SpectrumAnalyzer::push(const juce::dsp::AudioBlock<const float>& block) noexcept
+{
+    if (! capturing.load())
+        return;
+
+    const auto numChannels = juce::jmin((int)block.getNumChannels(), 2);
+    const auto numSamples = (int)block.getNumSamples();
+    const auto scope = fifo.write(numSamples);
+
+    const auto copy = [&](int start, int count, int offset)
+    {
+        auto* destination = fifoData.data() + start;
+
+        if (numChannels == 1)
+        {
+            juce::FloatVectorOperations::copy(destination, block.getChannelPointer(0) + offset, count);
+        }
+        else
+        {
+            juce::FloatVectorOperations::copy(destination, block.getChannelPointer(0) + offset, count);
+            juce::FloatVectorOperations::add(destination, block.getChannelPointer(1) + offset, count);
+            juce::FloatVectorOperations::multiply(destination, 0.5f, count);
+        }
+    };
+
+    // Whatever doesn't fit is dropped, the average just takes a little longer
+    copy(scope.startIndex1, scope.blockSize1, 0);
+    copy(scope.startIndex2, scope.blockSize2, scope.blockSize1);
+}
+
+void SpectrumAnalyzer::startCapture(Slot slot)
+{
+    if (! allocated.load())
+        allocate();
+
+    {
+        const juce::ScopedLock lock(averageLock);
+        std::fill(powerSums[slot].begin(), powerSums[slot].end(), 0.0);
+        numFrames[slot] = 0;
+    }
+
+    capturingSlot.store(slot);
+    restartRequested.store(true);
+    capturing.store(true);
+}
+
+void SpectrumAnalyzer::stopCapture()
+{
+    capturing.store(false);
+}
+
+int SpectrumAnalyzer::getAverageSpectrum(Slot slot, std::vector<float>& power) const
+{
+    const juce::ScopedLock lock(averageLock);
+
+    power.resize((size_t)numBins);
+
+    if (numFrames[slot] == 0)
+    {
+        std::fill(power.begin(), power.end(), 0.f);
+        return 0;
+    }
+
+    const auto scale = 1.0 / numFrames[slot];
+
+    for (size_t bin = 0; bin < power.size(); ++bin)
+        power[bin] = (float)(powerSums[slot][bin] * scale);
+
+    return numFrames[slot];
+}
+
+int SpectrumAnalyzer::useTimeSlice()
+{
+    // Samples from before a restart belong to the previous capture
+    if (restartRequested.exchange(false))
+    {
+        fifo.read(fifo.getNumReady());
+        frameFill = 0;
+    }
+
+    if (fifo.getNumReady() < hopSize)
+        return 20;
+
+    {
+        const auto scope = fifo.read(hopSize);
+
+        // Slide the frame along by one hop
+        if (frameFill == fftSize)
+        {
+            std::copy(frame.begin() + hopSize, frame.end(), frame.begin());
+            frameFill -= hopSize;
+        }
+
+        std::copy_n(fifoData.data() + scope.startIndex1, scope.blockSize1, frame.data() + frameFill);
+        std::copy_n(fifoData.data() + scope.startIndex2, scope.blockSize2, frame.data() + frameFill + scope.blockSize1);
+        frameFill += hopSize;
+    }
+
+    if (frameFill < fftSize)
+        return 0;
+
+    std::copy(frame.begin(), frame.end(), fftData.begin());
+    window->multiplyWithWindowingTable(fftData.data(), (size_t)fftSize);
+    fft->performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+    {
+        const juce::ScopedLock lock(averageLock);
+        auto& sums = powerSums[capturingSlot.load()];
+
+        for (size_t bin = 0; bin < sums.size(); ++bin)
+            sums[bin] += (double)fftData[bin] * fftData[bin];
+
+        ++numFrames[capturingSlot.load()];
+    }
+
+    // More hops may be waiting
+    return 0;
+}
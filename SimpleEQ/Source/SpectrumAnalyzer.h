@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.h
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "AnalysisThread.h"
+
+// Long-term average power spectrum of a mono or stereo signal, captured into
+// one of two slots. The audio thread only pushes the mid signal into a FIFO
+// while a capture is running; windowing, FFTs and averaging happen on the
+// shared analysis thread.
+class SpectrumAnalyzer : private juce::TimeSliceClient
+{
+public:
+    enum Slot
+    {
+        Slot_Reference,
+        Slot_Current,
+        numSlots
+    };
+
+    static constexpr int fftOrder = 12;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int numBins = fftSize / 2 + 1;
+
+    SpectrumAnalyzer() = default;
+    ~SpectrumAnalyzer() override;
+
+    void prepare(double sampleRate);
+    double getSampleRate() const noexcept { return sampleRate.load(); }
+
+    // Audio thread, does nothing unless capturing
+    void push(const juce::dsp::AudioBlock<const float>& block) noexcept;
+
+    // Starting a capture clears that slot's average. The buffers are only
+    // allocated by the first capture, so call it from the message thread.
+    void startCapture(Slot slot);
+    void stopCapture();
+    bool isCapturing() const noexcept { return capturing.load(); }
+
+    // Any thread but the audio thread. Mean power per FFT bin, bin k being
+    // k * sampleRate / fftSize Hz. Returns the number of frames averaged.
+    int getAverageSpectrum(Slot slot, std::vector<float>& power) const;
+
+    // Samples pushed but not analysed yet
+    int getNumPending() const noexcept { return fifo.getNumReady(); }
+
+private:
+    int useTimeSlice() override;
+    void allocate();
+
+    juce::SharedResourcePointer<AnalysisThread> analysisThread;
+
+    std::atomic<double> sampleRate{ 44100.0 };
+    std::atomic<bool> capturing{ false };
+    std::atomic<int> capturingSlot{ Slot_Reference };
+    std::atomic<bool> restartRequested{ false };
+
+    // Set once the buffers below exist, most instances never capture anything
+    std::atomic<bool> allocated{ false };
+
+    // About 0.7 s at 48 kHz, samples are dropped if the analysis falls further behind
+    static constexpr int fifoCapacity = 1 << 15;
+    juce::AbstractFifo fifo{ fifoCapacity };
+    std::vector<float> fifoData;
+
+    // Analysis thread state, frames overlap by three quarters
+    static constexpr int hopSize = fftSize / 4;
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::unique_ptr<juce::dsp::WindowingFunction<float>> window;
+    std::vector<float> frame, fftData;
+    int frameFill{ 0 };
+
+    mutable juce::CriticalSection averageLock;
+    std::vector<double> powerSums[numSlots];
+    int numFrames[numSlots]{};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumAnalyzer)
+};
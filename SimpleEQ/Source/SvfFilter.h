@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+
+    SvfFilter.h
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+enum class SvfType
+{
+    LowPass,
+    HighPass,
+    Peak,
+    LowShelf,
+    HighShelf
+};
+
+// Trapezoidal (TPT) state-variable filter after Andy Simper / Cytomic.
+// The transfer functions are identical to the RBJ biquads built by
+// juce::dsp::IIR::Coefficients, but a frequency/Q/gain change only touches
+// a handful of scalars, so the filter stays stable and cheap when modulated.
+struct SvfFilter
+{
+    void prepare(const juce::dsp::ProcessSpec& spec)
+    {
+        jassert(spec.numChannels == 1);
+
+        sampleRate = spec.sampleRate;
+
+        frequency.reset(sampleRate, rampLengthInSeconds);
+        q.reset(sampleRate, rampLengthInSeconds);
+        gainInDecibels.reset(sampleRate, rampLengthInSeconds);
+
+        reset();
+    }
+
+    // Clears the state and finishes any glide in progress.
+    void reset() noexcept
+    {
+        frequency.setCurrentAndTargetValue(frequency.getTargetValue());
+        q.setCurrentAndTargetValue(q.getTargetValue());
+        gainInDecibels.setCurrentAndTargetValue(gainInDecibels.getTargetValue());
+
+        updateCoefficients();
+
+        ic1eq = 0.f;
+        ic2eq = 0.f;
+    }
+
+    // Sets new targets. The filter glides towards them in steps of
+    // modulationInterval samples, so automation sweeps never need a redesign.
+    void setParameters(SvfType newType, float newFrequency, float newQ, float newGainInDecibels) noexcept
+    {
+        if (newType != type)
+        {
+            type = newType;
+            frequency.setCurrentAndTargetValue(newFrequency);
+            q.setCurrentAndTargetValue(newQ);
+            gainInDecibels.setCurrentAndTargetValue(newGainInDecibels);
+        }
+        else
+        {
+            frequency.setTargetValue(newFrequency);
+            q.setTargetValue(newQ);
+            gainInDecibels.setTargetValue(newGainInDecibels);
+        }
+
+        if (! isSmoothing())
+            updateCoefficients();
+    }
+
+    template <typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock = context.getOutputBlock();
+
+        jassert(inputBlock.getNumChannels() == 1);
+        jassert(outputBlock.getNumChannels() == 1);
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom(inputBlock);
+
+            return;
+        }
+
+        const auto numSamples = outputBlock.getNumSamples();
+        auto* src = inputBlock.getChannelPointer(0);
+        auto* dst = outputBlock.getChannelPointer(0);
+
+        size_t i = 0;
+        while (i < numSamples)
+        {
+            auto numToProcess = numSamples - i;
+
+            if (isSmoothing())
+            {
+                numToProcess = juce::jmin(numToProcess, (size_t)modulationInterval);
+
+                frequency.skip((int)numToProcess);
+                q.skip((int)numToProcess);
+                gainInDecibels.skip((int)numToProcess);
+
+                updateCoefficients();
+            }
+
+            for (size_t j = 0; j < numToProcess; ++j)
+                dst[i + j] = processSample(src[i + j]);
+
+            i += numToProcess;
+        }
+
+        juce::dsp::util::snapToZero(ic1eq);
+        juce::dsp::util::snapToZero(ic2eq);
+    }
+
+    float processSample(float v0) noexcept
+    {
+        const auto v3 = v0 - ic2eq;
+        const auto v1 = a1 * ic1eq + a2 * v3;
+        const auto v2 = ic2eq + a2 * ic1eq + a3 * v3;
+
+        ic1eq = 2.f * v1 - ic1eq;
+        ic2eq = 2.f * v2 - ic2eq;
+
+        return m0 * v0 + m1 * v1 + m2 * v2;
+    }
+
+    bool isSmoothing() const noexcept
+    {
+        return frequency.isSmoothing() || q.isSmoothing() || gainInDecibels.isSmoothing();
+    }
+
+    // Number of samples between coefficient updates while a parameter glides.
+    static constexpr int modulationInterval = 16;
+    static constexpr double rampLengthInSeconds = 0.02;
+
+private:
+    void updateCoefficients() noexcept
+    {
+        const auto nyquistLimit = (float)(sampleRate * 0.49);
+        const auto f = juce::jlimit(10.f, nyquistLimit, frequency.getCurrentValue());
+        const auto A = std::pow(10.f, gainInDecibels.getCurrentValue() / 40.f);
+
+        auto g = std::tan(juce::MathConstants<float>::pi * f / (float)sampleRate);
+        auto k = 1.f / q.getCurrentValue();
+
+        switch (type)
+        {
+        case SvfType::LowPass:
+            m0 = 0.f; m1 = 0.f; m2 = 1.f;
+            break;
+        case SvfType::HighPass:
+            m0 = 1.f; m1 = -k; m2 = -1.f;
+            break;
+        case SvfType::Peak:
+            k = 1.f / (q.getCurrentValue() * A);
+            m0 = 1.f; m1 = k * (A * A - 1.f); m2 = 0.f;
+            break;
+        case SvfType::LowShelf:
+            g /= std::sqrt(A);
+            m0 = 1.f; m1 = k * (A - 1.f); m2 = A * A - 1.f;
+            break;
+        case SvfType::HighShelf:
+            g *= std::sqrt(A);
+            m0 = A * A; m1 = k * (1.f - A) * A; m2 = 1.f - A * A;
+            break;
+        }
+
+        a1 = 1.f / (1.f + g * (g + k));
+        a2 = g * a1;
+        a3 = g * a2;
+    }
+
+    SvfType type{ SvfType::Peak };
+    double sampleRate{ 44100.0 };
+
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> frequency{ 1000.f };
+    juce::SmoothedValue<float> q{ 0.7071f }, gainInDecibels{ 0.f };
+
+    float a1{ 0 }, a2{ 0 }, a3{ 0 };
+    float m0{ 1 }, m1{ 0 }, m2{ 0 };
+    float ic1eq{ 0 }, ic2eq{ 0 };
+};
+
+using SvfCutFilter = juce::dsp::ProcessorChain<SvfFilter, SvfFilter, SvfFilter, SvfFilter>;
+
+using SvfMonoChain = juce::dsp::ProcessorChain<SvfCutFilter, SvfFilter, SvfFilter, SvfFilter, SvfFilter, SvfFilter, SvfCutFilter>;
+
+// Q of the given second order section of an even order Butterworth filter,
+// matching juce::dsp::FilterDesign's HighOrderButterworthMethod.
+inline float getButterworthQ(int order, int section)
+{
+    return (float)(1.0 / (2.0 * std::cos((2.0 * section + 1.0) * juce::MathConstants<double>::pi / (order * 2.0))));
+}
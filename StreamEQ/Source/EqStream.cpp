@@ -0,0 +1,253 @@
+/*
+  ==============================================================================
+
+    EqStream.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "EqStream.h"
+
+#include <unistd.h>
+#include <cerrno>
+
+bool StreamFormat::isValid() const
+{
+    return sampleRate >= 8000.0 && sampleRate <= 384000.0
+        && numChannels >= 1 && numChannels <= maxChannels
+        && blockSize >= 1 && blockSize <= 8192;
+}
+
+juce::String StreamFormat::toString() const
+{
+    return "rate=" + juce::String(sampleRate, 0)
+         + " channels=" + juce::String(numChannels)
+         + " format=" + (sampleFormat == SampleFormat::Float32 ? "f32" : "s16")
+         + " block=" + juce::String(blockSize);
+}
+
+bool parseStreamHeader(const juce::String& line, juce::String& name, StreamFormat& format)
+{
+    auto tokens = juce::StringArray::fromTokens(line.trim(), " ", {});
+    tokens.removeEmptyStrings();
+
+    if (tokens.isEmpty() || tokens[0].containsChar('='))
+        return false;
+
+    name = tokens[0];
+
+    for (int i = 1; i < tokens.size(); ++i)
+    {
+        const auto key = tokens[i].upToFirstOccurrenceOf("=", false, false);
+        const auto value = tokens[i].fromFirstOccurrenceOf("=", false, false);
+
+        if (key == "rate")
+            format.sampleRate = value.getDoubleValue();
+        else if (key == "channels")
+            format.numChannels = value.getIntValue();
+        else if (key == "block")
+            format.blockSize = value.getIntValue();
+        else if (key == "format" && (value == "f32" || value == "s16"))
+            format.sampleFormat = value == "f32" ? SampleFormat::Float32 : SampleFormat::Int16;
+        else
+            return false;
+    }
+
+    return format.isValid();
+}
+
+EqStream::EqStream(const juce::String& streamName, const StreamFormat& streamFormat, int input, int output, const ChainSettings& initialSettings)
+    : name(streamName), format(streamFormat), inputFd(input), outputFd(output),
+      blockBytes(streamFormat.blockSize * streamFormat.getBytesPerFrame()),
+      chains((size_t)streamFormat.numChannels),
+      data((size_t)blockBytes),
+      settings(initialSettings)
+{
+    const juce::dsp::ProcessSpec spec{ format.sampleRate, (juce::uint32)format.blockSize, 1 };
+    const auto coefficients = makeChainCoefficients(settings, format.sampleRate);
+
+    for (auto& chain : chains)
+    {
+        chain.prepare(spec);
+        applyChainCoefficients(chain, coefficients);
+    }
+
+    if (format.numChannels > 1 || format.sampleFormat != SampleFormat::Float32)
+        planar.setSize(format.numChannels, format.blockSize);
+}
+
+EqStream::~EqStream()
+{
+    ::close(inputFd);
+
+    if (outputFd != inputFd)
+        ::close(outputFd);
+}
+
+void EqStream::setSettings(const ChainSettings& newSettings)
+{
+    // Designed before taking the lock, so the worker never finds it held for long
+    const auto coefficients = makeChainCoefficients(newSettings, format.sampleRate);
+
+    const juce::SpinLock::ScopedLockType lock(settingsLock);
+    settings = newSettings;
+    pendingCoefficients = coefficients;
+    coefficientsPending.store(true);
+}
+
+ChainSettings EqStream::getSettings() const
+{
+    const juce::SpinLock::ScopedLockType lock(settingsLock);
+    return settings;
+}
+
+void EqStream::applyPendingCoefficients()
+{
+    if (! coefficientsPending.load())
+        return;
+
+    // Busy means the control thread is mid-swap, try again next block
+    const juce::SpinLock::ScopedTryLockType lock(settingsLock);
+
+    if (! lock.isLocked())
+        return;
+
+    for (auto& chain : chains)
+        applyChainCoefficients(chain, pendingCoefficients);
+
+    coefficientsPending.store(false);
+}
+
+EqStream::Status EqStream::service()
+{
+    for (;;)
+    {
+        // Finish draining the last block before reading into the buffer again
+        if (! flush())
+            return Status::WaitingForOutput;
+
+        if (inputFinished)
+            return Status::Finished;
+
+        const auto numRead = ::read(inputFd, data.get() + inputSize, (size_t)(blockBytes - inputSize));
+
+        if (numRead > 0)
+        {
+            inputSize += (int)numRead;
+
+            if (inputSize == blockBytes)
+                processBlock(format.blockSize);
+
+            continue;
+        }
+
+        if (numRead < 0 && errno == EINTR)
+            continue;
+
+        if (numRead < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            return Status::WaitingForInput;
+
+        // End of stream, or an error: pass the last whole frames on, then stop
+        inputFinished = true;
+
+        if (const auto numFrames = inputSize / format.getBytesPerFrame(); numFrames > 0 && numRead == 0)
+            processBlock(numFrames);
+    }
+}
+
+bool EqStream::flush()
+{
+    while (outputPosition < outputSize)
+    {
+        const auto numWritten = ::write(outputFd, data.get() + outputPosition, (size_t)(outputSize - outputPosition));
+
+        if (numWritten > 0)
+        {
+            outputPosition += (int)numWritten;
+            continue;
+        }
+
+        if (numWritten < 0 && errno == EINTR)
+            continue;
+
+        if (numWritten < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            return false;
+
+        // The reader went away, nothing more to do for this stream
+        inputFinished = true;
+        outputPosition = outputSize = 0;
+        return true;
+    }
+
+    outputPosition = outputSize = 0;
+    return true;
+}
+
+void EqStream::processBlock(int numFrames)
+{
+    const auto start = juce::Time::getHighResolutionTicks();
+    applyPendingCoefficients();
+
+    const auto numChannels = format.numChannels;
+
+    const auto processChannel = [this, numFrames](int channel, float* samples)
+    {
+        juce::dsp::AudioBlock<float> block(&samples, 1, (size_t)numFrames);
+        chains[(size_t)channel].process(juce::dsp::ProcessContextReplacing<float>(block));
+    };
+
+    if (format.sampleFormat == SampleFormat::Float32)
+    {
+        auto* interleaved = reinterpret_cast<float*>(data.get());
+
+        if (numChannels == 1)
+        {
+            // Already contiguous, processed where it was read
+            processChannel(0, interleaved);
+        }
+        else
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                auto* samples = planar.getWritePointer(channel);
+
+                for (int i = 0; i < numFrames; ++i)
+                    samples[i] = interleaved[i * numChannels + channel];
+
+                processChannel(channel, samples);
+
+                for (int i = 0; i < numFrames; ++i)
+                    interleaved[i * numChannels + channel] = samples[i];
+            }
+        }
+    }
+    else
+    {
+        auto* interleaved = reinterpret_cast<juce::int16*>(data.get());
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto* samples = planar.getWritePointer(channel);
+
+            for (int i = 0; i < numFrames; ++i)
+                samples[i] = (float)interleaved[i * numChannels + channel] * (1.f / 32768.f);
+
+            processChannel(channel, samples);
+
+            for (int i = 0; i < numFrames; ++i)
+                interleaved[i * numChannels + channel] = (juce::int16)juce::jlimit(-32768, 32767, juce::roundToInt(samples[i] * 32768.f));
+        }
+    }
+
+    inputSize = 0;
+    outputPosition = 0;
+    outputSize = numFrames * format.getBytesPerFrame();
+    framesProcessed.fetch_add(numFrames);
+
+    const auto elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1.0e6;
+
+    if (elapsed > worstBlockMicroseconds.load())
+        worstBlockMicroseconds.store(elapsed);
+}
@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    EqStream.h
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../SimpleEQ/Source/PluginProcessor.h"
+
+enum class SampleFormat
+{
+    Float32,
+    Int16,
+};
+
+// Interleaved little-endian PCM, processed blockSize frames at a time
+struct StreamFormat
+{
+    double sampleRate{ 48000.0 };
+    int numChannels{ 2 };
+    SampleFormat sampleFormat{ SampleFormat::Float32 };
+    int blockSize{ 64 };
+
+    static constexpr int maxChannels = 8;
+
+    int getBytesPerFrame() const { return numChannels * (sampleFormat == SampleFormat::Float32 ? 4 : 2); }
+
+    // A block has to arrive in full before its first sample can be processed,
+    // the EQ itself adds no delay
+    double getLatencyInMilliseconds() const { return 1000.0 * blockSize / sampleRate; }
+
+    bool isValid() const;
+    juce::String toString() const;
+};
+
+// Reads "<name> [rate=48000] [channels=2] [format=f32|s16] [block=64]",
+// with missing keys taken from format. Returns false if the line is malformed.
+bool parseStreamHeader(const juce::String& line, juce::String& name, StreamFormat& format);
+
+// One PCM stream through a MonoChain per channel. The stream owns its file
+// descriptors, which must be non-blocking; input and output may be the same
+// socket. Audio is read into a single block buffer, processed in it and
+// written back out from it, so nothing is allocated or copied per block
+// beyond the (de)interleaving that MonoChain needs.
+class EqStream
+{
+public:
+    EqStream(const juce::String& name, const StreamFormat& format, int inputFd, int outputFd, const ChainSettings& settings);
+    ~EqStream();
+
+    const juce::String& getName() const { return name; }
+    const StreamFormat& getFormat() const { return format; }
+
+    // Control thread. Designs the coefficients there and hands them to the
+    // worker, which picks them up at the next block boundary.
+    void setSettings(const ChainSettings& newSettings);
+    ChainSettings getSettings() const;
+
+    enum class Status
+    {
+        WaitingForInput,
+        WaitingForOutput,
+        Finished,
+    };
+
+    // Worker thread. Reads whatever is available, processes every complete
+    // block and writes it out, until one of the descriptors would block.
+    Status service();
+
+    // What to poll for after service() returned status
+    int getPollDescriptor(Status status) const { return status == Status::WaitingForOutput ? outputFd : inputFd; }
+
+    // Any thread
+    juce::int64 getFramesProcessed() const { return framesProcessed.load(); }
+    double getWorstBlockMicroseconds() const { return worstBlockMicroseconds.load(); }
+
+private:
+    void applyPendingCoefficients();
+    void processBlock(int numFrames);
+    bool flush();
+
+    const juce::String name;
+    const StreamFormat format;
+    const int inputFd, outputFd;
+    const int blockBytes;
+
+    std::vector<MonoChain> chains;
+
+    // The block being filled, processed and drained, in that order
+    juce::HeapBlock<char> data;
+    int inputSize{ 0 };
+    int outputPosition{ 0 }, outputSize{ 0 };
+    bool inputFinished{ false };
+
+    // Planar scratch for the chains, unused for mono float streams
+    juce::AudioBuffer<float> planar;
+
+    // Held by the control thread only to swap new coefficients in, the worker
+    // never waits for it
+    juce::SpinLock settingsLock;
+    ChainSettings settings;
+    ChainCoefficients pendingCoefficients;
+    std::atomic<bool> coefficientsPending{ false };
+
+    std::atomic<juce::int64> framesProcessed{ 0 };
+    std::atomic<double> worstBlockMicroseconds{ 0.0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EqStream)
+};
@@ -0,0 +1,231 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "StreamServer.h"
+
+#include <csignal>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+    std::atomic<bool> stopRequested{ false };
+
+    void printUsage()
+    {
+        std::cerr << "Usage: StreamEQ [options]" << std::endl << std::endl
+                  << "  --stdin                 EQ stdin to stdout (the default without --listen or --fifo)" << std::endl
+                  << "  --fifo <in> <out>       EQ one named pipe into another" << std::endl
+                  << "  --listen <path>         accept streams on a Unix domain socket" << std::endl
+                  << "  --control <path>        accept parameter updates on a Unix domain socket" << std::endl
+                  << "  --loopback <n> [secs]   self test: n streams over socket pairs, as fast as possible" << std::endl
+                  << "  --rate <Hz>             default 48000" << std::endl
+                  << "  --channels <n>          default 2" << std::endl
+                  << "  --format <f32|s16>      interleaved little-endian, default f32" << std::endl
+                  << "  --block <frames>        default 64" << std::endl
+                  << "  --workers <n>           default: number of CPU cores" << std::endl;
+    }
+
+    // Round trip through the daemon of one block per stream, every stream at
+    // once, which has to fit in one block's duration to keep up
+    int runLoopback(StreamServer& server, const StreamFormat& format, int numStreams, double seconds)
+    {
+        std::vector<int> clients;
+
+        for (int i = 0; i < numStreams; ++i)
+        {
+            int pair[2];
+
+            if (::socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0)
+            {
+                std::cerr << "Can't create stream " << i << std::endl;
+                break;
+            }
+
+            if (! server.addStream("loop" + juce::String(i), format, pair[1], pair[1]))
+            {
+                ::close(pair[0]);
+                continue;
+            }
+
+            clients.push_back(pair[0]);
+        }
+
+        const auto blockBytes = format.blockSize * format.getBytesPerFrame();
+        juce::HeapBlock<char> block((size_t)blockBytes, true);
+        juce::Random random(1234);
+
+        if (format.sampleFormat == SampleFormat::Float32)
+            for (int i = 0; i < blockBytes / 4; ++i)
+                reinterpret_cast<float*>(block.get())[i] = (random.nextFloat() * 2.f - 1.f) * 0.25f;
+        else
+            for (int i = 0; i < blockBytes / 2; ++i)
+                reinterpret_cast<juce::int16*>(block.get())[i] = (juce::int16)random.nextInt({ -8192, 8192 });
+
+        const auto transfer = [blockBytes](int fd, char* data, bool writing)
+        {
+            for (int position = 0; position < blockBytes;)
+            {
+                const auto count = writing ? ::write(fd, data + position, (size_t)(blockBytes - position))
+                                           : ::read(fd, data + position, (size_t)(blockBytes - position));
+
+                if (count <= 0)
+                    return false;
+
+                position += (int)count;
+            }
+
+            return true;
+        };
+
+        juce::HeapBlock<char> received((size_t)blockBytes);
+        const auto budget = format.getLatencyInMilliseconds();
+        const auto numRounds = juce::jmax(1, (int)(seconds * format.sampleRate / format.blockSize));
+        double total = 0, worst = 0;
+        int late = 0;
+
+        for (int round = 0; round < numRounds && ! stopRequested.load(); ++round)
+        {
+            // Parameter traffic on the side channel while the audio runs
+            if (round % 100 == 0)
+                server.handleCommand("set * Peak 1 Gain=" + juce::String(random.nextFloat() * 24.f - 12.f)
+                                     + "; Peak 1 Freq=" + juce::String(200.f + random.nextFloat() * 5000.f));
+
+            const auto start = juce::Time::getMillisecondCounterHiRes();
+
+            for (auto fd : clients)
+                transfer(fd, block.get(), true);
+
+            for (auto fd : clients)
+                transfer(fd, received.get(), false);
+
+            const auto elapsed = juce::Time::getMillisecondCounterHiRes() - start;
+            total += elapsed;
+            worst = juce::jmax(worst, elapsed);
+
+            if (elapsed > budget)
+                ++late;
+        }
+
+        double worstBlock = 0;
+
+        for (const auto& stream : server.getStreams())
+            worstBlock = juce::jmax(worstBlock, stream->getWorstBlockMicroseconds());
+
+        for (auto fd : clients)
+            ::close(fd);
+
+        std::cout << clients.size() << " streams, " << format.toString() << std::endl
+                  << "Latency per stream: " << juce::String(budget, 2) << " ms buffering plus the round trip below" << std::endl
+                  << "Round trip of one block on every stream: mean " << juce::String(total / numRounds, 3)
+                  << " ms, worst " << juce::String(worst, 3) << " ms, "
+                  << late << " of " << numRounds << " rounds over the " << juce::String(budget, 2) << " ms budget" << std::endl
+                  << "Worst single block inside the daemon: " << juce::String(worstBlock, 1) << " us" << std::endl;
+
+        return late == 0 ? 0 : 1;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    // The parameter defaults come from a processor, which expects a message manager
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(argv[i]);
+
+    if (juce::ByteOrder::isBigEndian())
+    {
+        std::cerr << "StreamEQ only handles little-endian PCM on little-endian hosts" << std::endl;
+        return 1;
+    }
+
+    const auto getOption = [&args](const juce::String& option, int offset = 1)
+    {
+        const auto index = args.indexOf(option);
+        return index >= 0 ? args[index + offset] : juce::String();
+    };
+
+    StreamFormat format;
+
+    if (args.contains("--rate"))
+        format.sampleRate = getOption("--rate").getDoubleValue();
+    if (args.contains("--channels"))
+        format.numChannels = getOption("--channels").getIntValue();
+    if (args.contains("--block"))
+        format.blockSize = getOption("--block").getIntValue();
+    if (args.contains("--format"))
+        format.sampleFormat = getOption("--format") == "s16" ? SampleFormat::Int16 : SampleFormat::Float32;
+
+    if (! format.isValid() || args.contains("--help"))
+    {
+        printUsage();
+        return 1;
+    }
+
+    // Readers that go away show up as write errors on their stream only
+    std::signal(SIGPIPE, SIG_IGN);
+    std::signal(SIGINT, [](int) { stopRequested.store(true); });
+    std::signal(SIGTERM, [](int) { stopRequested.store(true); });
+
+    const auto numWorkers = args.contains("--workers") ? getOption("--workers").getIntValue()
+                                                       : juce::SystemStats::getNumCpus();
+    StreamServer server(numWorkers, format);
+
+    if (args.contains("--control") && ! server.listenForControl(getOption("--control")))
+    {
+        std::cerr << "Can't listen on " << getOption("--control") << std::endl;
+        return 1;
+    }
+
+    if (args.contains("--loopback"))
+    {
+        const auto seconds = getOption("--loopback", 2).getDoubleValue();
+        return runLoopback(server, format, juce::jmax(1, getOption("--loopback").getIntValue()), seconds > 0 ? seconds : 10.0);
+    }
+
+    const auto listening = args.contains("--listen");
+
+    if (listening)
+    {
+        if (! server.listen(getOption("--listen")))
+        {
+            std::cerr << "Can't listen on " << getOption("--listen") << std::endl;
+            return 1;
+        }
+    }
+    else if (args.contains("--fifo"))
+    {
+        // Opening blocks until the other ends are open too
+        const auto input = ::open(getOption("--fifo").toRawUTF8(), O_RDONLY);
+        const auto output = input >= 0 ? ::open(getOption("--fifo", 2).toRawUTF8(), O_WRONLY) : -1;
+
+        if (output < 0 || ! server.addStream("fifo", format, input, output))
+        {
+            std::cerr << "Can't open the FIFOs" << std::endl;
+            return 1;
+        }
+    }
+    else if (! server.addStream("stdin", format, STDIN_FILENO, STDOUT_FILENO))
+    {
+        return 1;
+    }
+
+    std::cerr << "StreamEQ: " << format.toString() << ", "
+              << juce::String(format.getLatencyInMilliseconds(), 2) << " ms latency per stream" << std::endl;
+
+    // A daemon runs until it is told to stop, a single stream until it ends
+    while (! stopRequested.load() && (listening || server.getNumStreams() > 0))
+        juce::Thread::sleep(50);
+
+    return 0;
+}
@@ -0,0 +1,526 @@
+/*
+  ==============================================================================
+
+    StreamServer.cpp
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#include "StreamServer.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+    bool setNonBlocking(int fd)
+    {
+        const auto flags = ::fcntl(fd, F_GETFL, 0);
+        return flags >= 0 && ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+    }
+
+    int createListeningSocket(const juce::String& path)
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+
+        if (path.getNumBytesAsUTF8() >= sizeof(address.sun_path))
+            return -1;
+
+        path.copyToUTF8(address.sun_path, sizeof(address.sun_path));
+
+        const auto fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+        if (fd < 0)
+            return -1;
+
+        ::unlink(address.sun_path);
+
+        if (::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+            || ::listen(fd, SOMAXCONN) != 0)
+        {
+            ::close(fd);
+            return -1;
+        }
+
+        return fd;
+    }
+
+    void writeLine(int fd, const juce::String& line)
+    {
+        const auto text = (line + "\n").toStdString();
+
+        for (size_t position = 0; position < text.size();)
+        {
+            const auto numWritten = ::write(fd, text.data() + position, text.size() - position);
+
+            if (numWritten < 0 && errno == EINTR)
+                continue;
+
+            if (numWritten <= 0)
+                return;
+
+            position += (size_t)numWritten;
+        }
+    }
+}
+
+//==============================================================================
+// Polls its streams' descriptors and services whichever are ready. New
+// streams arrive through an inbox and a wake-up pipe, so the poll loop only
+// allocates when the set of streams changes.
+class StreamServer::Worker : public juce::Thread
+{
+public:
+    Worker(StreamServer& owner, int index)
+        : juce::Thread("Stream worker " + juce::String(index)), server(owner)
+    {
+        if (::pipe(wakePipe) == 0)
+        {
+            setNonBlocking(wakePipe[0]);
+            setNonBlocking(wakePipe[1]);
+        }
+
+        startThread(juce::Thread::Priority::highest);
+    }
+
+    ~Worker() override
+    {
+        signalThreadShouldExit();
+        wake();
+        stopThread(2000);
+
+        ::close(wakePipe[0]);
+        ::close(wakePipe[1]);
+    }
+
+    void add(std::shared_ptr<EqStream> stream)
+    {
+        {
+            const juce::ScopedLock lock(inboxLock);
+            inbox.push_back(std::move(stream));
+        }
+
+        ++numStreams;
+        wake();
+    }
+
+    int getNumStreams() const { return numStreams.load(); }
+
+    void run() override
+    {
+        struct Entry
+        {
+            std::shared_ptr<EqStream> stream;
+            EqStream::Status status;
+        };
+
+        std::vector<Entry> entries;
+        std::vector<pollfd> descriptors;
+
+        while (! threadShouldExit())
+        {
+            {
+                const juce::ScopedLock lock(inboxLock);
+
+                for (auto& stream : inbox)
+                    entries.push_back({ std::move(stream), EqStream::Status::WaitingForInput });
+
+                inbox.clear();
+            }
+
+            descriptors.clear();
+            descriptors.push_back({ wakePipe[0], POLLIN, 0 });
+
+            for (const auto& entry : entries)
+                descriptors.push_back({ entry.stream->getPollDescriptor(entry.status),
+                                        (short)(entry.status == EqStream::Status::WaitingForOutput ? POLLOUT : POLLIN), 0 });
+
+            if (::poll(descriptors.data(), (nfds_t)descriptors.size(), -1) < 0 && errno != EINTR)
+                break;
+
+            if (descriptors[0].revents != 0)
+            {
+                char buffer[64];
+                while (::read(wakePipe[0], buffer, sizeof(buffer)) > 0) {}
+            }
+
+            // Hang-ups and errors are ready too, service() finds out what happened
+            for (size_t i = 0; i < entries.size(); ++i)
+                if (descriptors[i + 1].revents != 0)
+                    entries[i].status = entries[i].stream->service();
+
+            for (auto it = entries.begin(); it != entries.end();)
+            {
+                if (it->status != EqStream::Status::Finished)
+                {
+                    ++it;
+                    continue;
+                }
+
+                server.removeStream(*it->stream);
+                it = entries.erase(it);
+                --numStreams;
+            }
+        }
+    }
+
+private:
+    void wake()
+    {
+        const char byte = 0;
+        [[maybe_unused]] const auto result = ::write(wakePipe[1], &byte, 1);
+    }
+
+    StreamServer& server;
+    int wakePipe[2]{ -1, -1 };
+
+    juce::CriticalSection inboxLock;
+    std::vector<std::shared_ptr<EqStream>> inbox;
+    std::atomic<int> numStreams{ 0 };
+};
+
+//==============================================================================
+// Accepts connections on a Unix domain socket and reads text lines from them.
+// The callback returns false once it has taken the connection over, after
+// which the listener forgets it without closing it.
+class StreamServer::Listener : public juce::Thread
+{
+public:
+    using LineCallback = std::function<bool(int fd, const juce::String& line)>;
+
+    // Reading a byte at a time leaves whatever follows the first line unread,
+    // for whoever takes the connection over
+    Listener(const juce::String& name, const juce::String& socketPath, int fd, bool readBytewise, LineCallback callback)
+        : juce::Thread(name), path(socketPath), listeningFd(fd), bytewise(readBytewise), onLine(std::move(callback))
+    {
+        startThread();
+    }
+
+    ~Listener() override
+    {
+        stopThread(2000);
+
+        for (const auto& client : clients)
+            ::close(client.fd);
+
+        ::close(listeningFd);
+        ::unlink(path.toRawUTF8());
+    }
+
+    void run() override
+    {
+        std::vector<pollfd> descriptors;
+
+        while (! threadShouldExit())
+        {
+            descriptors.clear();
+            descriptors.push_back({ listeningFd, POLLIN, 0 });
+
+            for (const auto& client : clients)
+                descriptors.push_back({ client.fd, POLLIN, 0 });
+
+            // Short timeout, to notice threadShouldExit()
+            if (::poll(descriptors.data(), (nfds_t)descriptors.size(), 200) <= 0)
+                continue;
+
+            for (size_t i = clients.size(); i-- > 0;)
+                if (descriptors[i + 1].revents != 0 && ! readFrom(clients[i]))
+                    clients.erase(clients.begin() + (ptrdiff_t)i);
+
+            if (descriptors[0].revents & POLLIN)
+            {
+                const auto fd = ::accept(listeningFd, nullptr, nullptr);
+
+                if (fd >= 0)
+                    clients.push_back({ fd, {} });
+            }
+        }
+    }
+
+private:
+    struct Client
+    {
+        int fd;
+        std::string pending;
+    };
+
+    // False once the connection is closed or handed over
+    bool readFrom(Client& client)
+    {
+        char buffer[512];
+        const auto numRead = ::read(client.fd, buffer, bytewise ? 1 : sizeof(buffer));
+
+        if (numRead < 0 && errno == EINTR)
+            return true;
+
+        if (numRead <= 0 || client.pending.size() > 4096)
+        {
+            ::close(client.fd);
+            return false;
+        }
+
+        client.pending.append(buffer, (size_t)numRead);
+
+        for (auto newline = client.pending.find('\n'); newline != std::string::npos; newline = client.pending.find('\n'))
+        {
+            const auto line = juce::String::fromUTF8(client.pending.data(), (int)newline);
+            client.pending.erase(0, newline + 1);
+
+            if (! onLine(client.fd, line))
+                return false;
+        }
+
+        return true;
+    }
+
+    const juce::String path;
+    const int listeningFd;
+    const bool bytewise;
+    LineCallback onLine;
+
+    std::vector<Client> clients;
+};
+
+//==============================================================================
+StreamServer::StreamServer(int numWorkers, const StreamFormat& format)
+    : defaultFormat(format), defaultSettings(getChainSettings(parameterSource.apvts))
+{
+    for (int i = 0; i < juce::jmax(1, numWorkers); ++i)
+        workers.push_back(std::make_unique<Worker>(*this, i));
+}
+
+StreamServer::~StreamServer()
+{
+    streamListener.reset();
+    controlListener.reset();
+    workers.clear();
+}
+
+bool StreamServer::addStream(const juce::String& name, const StreamFormat& format, int inputFd, int outputFd)
+{
+    const auto closeDescriptors = [inputFd, outputFd]
+    {
+        ::close(inputFd);
+
+        if (outputFd != inputFd)
+            ::close(outputFd);
+    };
+
+    if (! format.isValid() || findStream(name) != nullptr
+        || ! setNonBlocking(inputFd) || ! setNonBlocking(outputFd))
+    {
+        closeDescriptors();
+        return false;
+    }
+
+    auto stream = std::make_shared<EqStream>(name, format, inputFd, outputFd, defaultSettings);
+
+    {
+        const juce::ScopedLock lock(streamsLock);
+        streams.push_back(stream);
+    }
+
+    // The least loaded worker takes it
+    auto* worker = std::min_element(workers.begin(), workers.end(), [](const auto& a, const auto& b)
+    {
+        return a->getNumStreams() < b->getNumStreams();
+    })->get();
+
+    worker->add(std::move(stream));
+    return true;
+}
+
+bool StreamServer::listen(const juce::String& socketPath)
+{
+    const auto fd = createListeningSocket(socketPath);
+
+    if (fd < 0)
+        return false;
+
+    streamListener = std::make_unique<Listener>("Stream listener", socketPath, fd, true, [this](int client, const juce::String& line)
+    {
+        juce::String name;
+        auto format = defaultFormat;
+
+        if (! parseStreamHeader(line, name, format))
+        {
+            writeLine(client, "error: expected <name> [rate=] [channels=] [format=f32|s16] [block=]");
+            ::close(client);
+        }
+        else if (findStream(name) != nullptr)
+        {
+            writeLine(client, "error: stream " + name + " already exists");
+            ::close(client);
+        }
+        else
+        {
+            addStream(name, format, client, client);
+        }
+
+        return false;
+    });
+
+    return true;
+}
+
+bool StreamServer::listenForControl(const juce::String& socketPath)
+{
+    const auto fd = createListeningSocket(socketPath);
+
+    if (fd < 0)
+        return false;
+
+    controlListener = std::make_unique<Listener>("Control listener", socketPath, fd, false, [this](int client, const juce::String& line)
+    {
+        writeLine(client, handleCommand(line));
+        return true;
+    });
+
+    return true;
+}
+
+juce::String StreamServer::handleCommand(const juce::String& line)
+{
+    const juce::ScopedLock lock(commandLock);
+
+    const auto trimmed = line.trim();
+    const auto command = trimmed.upToFirstOccurrenceOf(" ", false, false);
+    const auto arguments = trimmed.fromFirstOccurrenceOf(" ", false, false).trim();
+    const auto streamName = arguments.upToFirstOccurrenceOf(" ", false, false);
+    const auto rest = arguments.fromFirstOccurrenceOf(" ", false, false).trim();
+
+    if (command == "set")
+        return setParameters(streamName, rest);
+
+    if (command == "preset")
+        return loadPreset(streamName, rest);
+
+    if (command == "list")
+    {
+        juce::StringArray lines;
+
+        for (const auto& stream : getStreams())
+            lines.add(stream->getName() + " " + stream->getFormat().toString()
+                      + " latency=" + juce::String(stream->getFormat().getLatencyInMilliseconds(), 2) + "ms"
+                      + " frames=" + juce::String(stream->getFramesProcessed())
+                      + " worst=" + juce::String(stream->getWorstBlockMicroseconds(), 1) + "us");
+
+        lines.add("ok " + juce::String(lines.size()) + " streams");
+        return lines.joinIntoString("\n");
+    }
+
+    return "error: unknown command " + command;
+}
+
+juce::String StreamServer::setParameters(const juce::String& streamName, const juce::String& assignments)
+{
+    std::vector<std::pair<juce::String, float>> values;
+
+    for (const auto& assignment : juce::StringArray::fromTokens(assignments, ";", {}))
+    {
+        if (assignment.trim().isEmpty())
+            continue;
+
+        const auto parameterID = assignment.upToFirstOccurrenceOf("=", false, false).trim();
+        auto* parameter = parameterSource.apvts.getParameter(parameterID);
+        ChainSettings probe;
+
+        // Only the static bands exist here: no dynamics, SVF topology or second set
+        const auto bands = setChainParameter(probe, parameterID, 0.f);
+
+        if (parameter == nullptr || ! bands.has_value() || *bands == 0 || parameterID == "Filter Topology")
+            return "error: no parameter " + parameterID;
+
+        if (! assignment.containsChar('='))
+            return "error: no value for " + parameterID;
+
+        const auto value = assignment.fromFirstOccurrenceOf("=", false, false).trim().getFloatValue();
+        values.emplace_back(parameterID, parameter->convertFrom0to1(parameter->convertTo0to1(value)));
+    }
+
+    if (values.empty())
+        return "error: nothing to set";
+
+    auto targets = streamName == "*" ? getStreams() : std::vector<std::shared_ptr<EqStream>>{ findStream(streamName) };
+
+    if (targets.empty() || targets.front() == nullptr)
+        return "error: no stream " + streamName;
+
+    for (const auto& stream : targets)
+    {
+        auto settings = stream->getSettings();
+
+        for (const auto& [parameterID, value] : values)
+            setChainParameter(settings, parameterID, value);
+
+        stream->setSettings(settings);
+    }
+
+    return "ok";
+}
+
+juce::String StreamServer::loadPreset(const juce::String& streamName, const juce::String& arguments)
+{
+    const auto path = arguments.upToLastOccurrenceOf(" ", false, false).trim();
+    const auto index = arguments.fromLastOccurrenceOf(" ", false, false).getIntValue();
+
+    PresetBank bank(juce::File::getCurrentWorkingDirectory().getChildFile(path));
+
+    if (! bank.isValid())
+        return "error: can't open preset bank " + path;
+
+    if (! parameterSource.loadPreset(bank, index))
+        return "error: no preset " + juce::String(index);
+
+    // The first set of bands, the daemon's chains are always linked
+    auto settings = getChainSettings(parameterSource.apvts);
+    settings.topology = Topology::Topology_Biquad;
+
+    auto targets = streamName == "*" ? getStreams() : std::vector<std::shared_ptr<EqStream>>{ findStream(streamName) };
+
+    if (targets.empty() || targets.front() == nullptr)
+        return "error: no stream " + streamName;
+
+    for (const auto& stream : targets)
+        stream->setSettings(settings);
+
+    return "ok " + juce::String::fromUTF8(bank.getName(index));
+}
+
+int StreamServer::getNumStreams() const
+{
+    const juce::ScopedLock lock(streamsLock);
+    return (int)streams.size();
+}
+
+std::vector<std::shared_ptr<EqStream>> StreamServer::getStreams() const
+{
+    const juce::ScopedLock lock(streamsLock);
+    return streams;
+}
+
+std::shared_ptr<EqStream> StreamServer::findStream(const juce::String& name) const
+{
+    const juce::ScopedLock lock(streamsLock);
+
+    for (const auto& stream : streams)
+        if (stream->getName() == name)
+            return stream;
+
+    return nullptr;
+}
+
+void StreamServer::removeStream(const EqStream& stream)
+{
+    const juce::ScopedLock lock(streamsLock);
+
+    streams.erase(std::remove_if(streams.begin(), streams.end(), [&stream](const auto& s) { return s.get() == &stream; }),
+                  streams.end());
+}
@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    StreamServer.h
+    Created: 19 Oct 2026
+    Author:  Medeses
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "EqStream.h"
+
+// Runs EqStreams on a fixed pool of worker threads, each polling its share of
+// the streams' descriptors, so hundreds of streams cost a handful of threads.
+// Streams come from the caller (stdin, FIFOs) or from a Unix domain socket,
+// where every connection is one stream. Parameter updates arrive as text
+// lines on a separate control socket.
+class StreamServer
+{
+public:
+    // New streams start from the plugin's default parameter values
+    StreamServer(int numWorkers, const StreamFormat& defaultFormat);
+    ~StreamServer();
+
+    // Takes ownership of the descriptors, which are made non-blocking
+    bool addStream(const juce::String& name, const StreamFormat& format, int inputFd, int outputFd);
+
+    // Accepts streams; each connection starts with a parseStreamHeader() line
+    bool listen(const juce::String& socketPath);
+
+    // Accepts parameter updates, see handleCommand()
+    bool listenForControl(const juce::String& socketPath);
+
+    // One command per line, answered with "ok" or "error: ...":
+    //   set <stream> <parameter ID>=<value>[; <parameter ID>=<value> ...]
+    //   preset <stream> <bank file> <index>
+    //   list
+    // Values are plain units, as in the plugin, and are clamped to the
+    // parameter's range. The stream "*" addresses every stream.
+    juce::String handleCommand(const juce::String& line);
+
+    int getNumStreams() const;
+    std::vector<std::shared_ptr<EqStream>> getStreams() const;
+
+private:
+    class Worker;
+    class Listener;
+
+    std::shared_ptr<EqStream> findStream(const juce::String& name) const;
+    void removeStream(const EqStream& stream);
+    juce::String setParameters(const juce::String& streamName, const juce::String& assignments);
+    juce::String loadPreset(const juce::String& streamName, const juce::String& arguments);
+
+    const StreamFormat defaultFormat;
+
+    // Only touched by the control thread, for defaults, ranges and presets
+    SimpleEQAudioProcessor parameterSource;
+    ChainSettings defaultSettings;
+    juce::CriticalSection commandLock;
+
+    mutable juce::CriticalSection streamsLock;
+    std::vector<std::shared_ptr<EqStream>> streams;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::unique_ptr<Listener> streamListener, controlListener;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StreamServer)
+};